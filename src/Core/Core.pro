@@ -2,7 +2,7 @@
 TEMPLATE = lib
 CONFIG += shared
 TARGET = Prototyper.Core
-QT += core gui widgets svg
+QT += core gui widgets svg concurrent
 CONFIG += c++14
 DEFINES += PROTOTYPER_CORE CFGFILE_QT_SUPPORT
 
@@ -48,6 +48,7 @@ HEADERS +=	exporter.hpp \
 			form_combobox.hpp \
 			page.hpp \
 			form_grid_snap.hpp \
+			form_object_snap.hpp \
 			form_group.hpp \
 			form_hslider.hpp \
 			form_image_handles.hpp \
@@ -98,7 +99,9 @@ HEADERS +=	exporter.hpp \
 			form_comment.hpp \
 			link_dlg.hpp \
 			form_text_properties.hpp \
-			form_text_style_properties.hpp
+			form_text_style_properties.hpp \
+			undo_history.hpp \
+			z_order.hpp
 
 SOURCES +=	exporter.cpp \
 			form_actions.cpp \
@@ -108,6 +111,7 @@ SOURCES +=	exporter.cpp \
 			form_combobox.cpp \
 			page.cpp \
 			form_grid_snap.cpp \
+			form_object_snap.cpp \
 			form_group.cpp \
 			form_hslider.cpp \
 			form_image_handles.cpp \
@@ -150,7 +154,9 @@ SOURCES +=	exporter.cpp \
 			form_comment.cpp \
 			link_dlg.cpp \
 			form_text_properties.cpp \
-			form_text_style_properties.cpp
+			form_text_style_properties.cpp \
+			undo_history.cpp \
+			z_order.cpp
 
 FORMS +=	grid_step_dlg.ui \
 			name_dlg.ui \
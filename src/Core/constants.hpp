@@ -53,9 +53,28 @@ static const qreal c_a4Width = 210.0;
 static const qreal c_a4Height = 297.0;
 static const qreal c_linePenWidth = 2.0;
 static const qreal c_headerFontSize = 20.0;
+static const qreal c_lodMinTextSize = 4.0;
+static const qreal c_lodMinItemSize = 4.0;
+static const qreal c_lodMinGridStep = 4.0;
+static const qreal c_lodProxySize = 64.0;
+static const qreal c_lodAntialiasingZoom = 0.5;
+static const int c_imagePreviewSize = 1024;
+static const int c_smoothScaleDelay = 100;
+static const int c_maxImageSize = 4096;
+static const int c_imagePlaceholderSize = 64;
+static const int c_undoLimit = 500;
+static const qint64 c_undoHistoryBudget = 64 * 1024 * 1024;
+static const qint64 c_undoMergeInterval = 1000;
+static const int c_paintCacheSize = 4096;
+static const qreal c_polylineIndexCellSize = 32.0;
+static const qreal c_polylineSimplifyTolerance = 0.1;
+static const qreal c_objectSnapTolerance = 5.0;
+static const int c_objectSnapRebuildRatio = 8;
 
 static const QColor c_textColor = Qt::black;
 static const QColor c_linkColor = QColor( 33, 122, 255 );
+static const QColor c_snapGuideColor = QColor( 255, 0, 255 );
+static const QColor c_imagePlaceholderColor = QColor( 220, 220, 220 );
 
 } /* namespace Core */
 
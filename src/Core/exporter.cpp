@@ -51,9 +51,10 @@ namespace Core {
 // ExporterPrivate
 //
 
-ExporterPrivate::ExporterPrivate( const Cfg::Project & cfg, Exporter * parent )
+ExporterPrivate::ExporterPrivate( const ProjectSnapshot & cfg, Exporter * parent )
 	:	q( parent )
-	,	m_cfg( cfg )
+	,	m_snapshot( cfg )
+	,	m_cfg( *m_snapshot )
 {
 }
 
@@ -69,8 +70,7 @@ static inline void drawLine( const Cfg::Line & line, QPainter & p, qreal dpi )
 {
 	p.save();
 
-	p.setPen( QPen( QColor( line.pen().color() ),
-		MmPx::instance().fromMm( line.pen().width(), dpi ) ) );
+	p.setPen( Cfg::fromPen( line.pen(), dpi ) );
 
 	p.drawLine( MmPx::instance().fromMm( line.p1().x() + line.pos().x(), dpi ),
 		MmPx::instance().fromMm( line.p1().y() + line.pos().y(), dpi ),
@@ -98,35 +98,33 @@ static inline void drawRect( const Cfg::Rect & rect, QPainter & p, qreal dpi )
 		MmPx::instance().fromMm( rect.size().width(), dpi ),
 		MmPx::instance().fromMm( rect.size().height(), dpi ) );
 
-	p.setPen( QPen( QColor( rect.pen().color() ),
-		MmPx::instance().fromMm( rect.pen().width(), dpi ) ) );
+	p.setPen( Cfg::fromPen( rect.pen(), dpi ) );
 
-	p.setBrush( QBrush( QColor( rect.brush().color() ) ) );
+	p.setBrush( Cfg::fromBrush( rect.brush() ) );
 
 	p.drawRect( r );
 
 	p.restore();
 }
 
-static inline QFont font( const Cfg::TextStyle & s, QPainter & p, qreal dpi )
+static inline QFont font( const Cfg::TextRun & s, QPainter & p, qreal dpi )
 {
 	Q_UNUSED( dpi )
 
 	QFont f = p.font();
 
-	if( std::find( s.style().cbegin(), s.style().cend(), Cfg::c_boldStyle ) !=
-		s.style().cend() )
-			f.setBold( true );
+	const Cfg::TextStyleFlags flags = s.m_style;
 
-	if( std::find( s.style().cbegin(), s.style().cend(), Cfg::c_italicStyle ) !=
-		s.style().cend() )
-			f.setItalic( true );
+	if( flags.testFlag( Cfg::BoldStyle ) )
+		f.setBold( true );
 
-	if( std::find( s.style().cbegin(), s.style().cend(), Cfg::c_underlineStyle ) !=
-		s.style().cend() )
-			f.setUnderline( true );
+	if( flags.testFlag( Cfg::ItalicStyle ) )
+		f.setItalic( true );
 
-	f.setPointSize( s.fontSize() );
+	if( flags.testFlag( Cfg::UnderlineStyle ) )
+		f.setUnderline( true );
+
+	f.setPointSize( s.m_fontSize );
 
 	return f;
 }
@@ -135,11 +133,10 @@ static inline void drawButton( const Cfg::Button & btn, QPainter & p, qreal dpi
 {
 	p.save();
 
-	p.setPen( QPen( QColor( btn.pen().color() ),
-		MmPx::instance().fromMm( btn.pen().width(), dpi ) ) );
-	p.setBrush( QBrush( QColor( btn.brush().color() ) ) );
+	p.setPen( Cfg::fromPen( btn.pen(), dpi ) );
+	p.setBrush( Cfg::fromBrush( btn.brush() ) );
 
-	p.setFont( font( btn.text(), p, dpi ) );
+	p.setFont( font( Cfg::textRun( btn.text() ), p, dpi ) );
 
 	const QRect r( MmPx::instance().fromMm( btn.pos().x(), dpi ),
 		MmPx::instance().fromMm( btn.pos().y(), dpi ),
@@ -164,7 +161,7 @@ static inline void drawCheckBox( const Cfg::CheckBox & chk, QPainter & p, qreal
 
 	FormCheckBox::draw( &p, Cfg::fromPen( chk.pen(), dpi ),
 		Cfg::fromBrush( chk.brush() ),
-		font( chk.text(), p, dpi ),
+		font( Cfg::textRun( chk.text() ), p, dpi ),
 		r,
 		MmPx::instance().fromMm( chk.size().width(), dpi ),
 		chk.isChecked(),
@@ -186,7 +183,7 @@ static inline void drawRadioButton( const Cfg::CheckBox & chk, QPainter & p, qre
 
 	FormRadioButton::draw( &p, Cfg::fromPen( chk.pen(), dpi ),
 		Cfg::fromBrush( chk.brush() ),
-		font( chk.text(), p, dpi ),
+		font( Cfg::textRun( chk.text() ), p, dpi ),
 		r,
 		MmPx::instance().fromMm( chk.width(), dpi ),
 		chk.isChecked(),
@@ -222,7 +219,7 @@ static inline void drawSpinBox( const Cfg::SpinBox & s, QPainter & p, qreal dpi
 			MmPx::instance().fromMm( s.size().height(), dpi ) ),
 		Cfg::fromPen( s.pen(), dpi ),
 		Cfg::fromBrush( s.brush() ),
-		font( s.text(), p, dpi ),
+		font( Cfg::textRun( s.text() ), p, dpi ),
 		s.text().text(),
 		dpi );
 
@@ -441,7 +438,7 @@ ExporterPrivate::drawForm( QSvgGenerator & svg, const Cfg::Page & form, qreal dp
 // Exporter
 //
 
-Exporter::Exporter( const Cfg::Project & project )
+Exporter::Exporter( const ProjectSnapshot & project )
 	:	d( new ExporterPrivate( project, this ) )
 {
 	d->init();
@@ -25,6 +25,7 @@
 
 // Qt include.
 #include <QScopedPointer>
+#include <QSharedPointer>
 
 // Prototyper include.
 #include "project_cfg.hpp"
@@ -41,6 +42,10 @@ namespace Core {
 
 class ExporterPrivate;
 
+//! Immutable snapshot of the project, cheap to share with exporters.
+using ProjectSnapshot = QSharedPointer< const Cfg::Project >;
+
+
 //
 // Exporter
 //
@@ -48,7 +53,7 @@ class ExporterPrivate;
 //! Base class for exporters to the doc.
 class Exporter {
 public:
-	explicit Exporter( const Cfg::Project & project );
+	explicit Exporter( const ProjectSnapshot & project );
 	virtual ~Exporter() = default;
 
 	//! Export documentation.
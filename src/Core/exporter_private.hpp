@@ -25,6 +25,7 @@
 
 // Prototyper include.
 #include "project_cfg.hpp"
+#include "exporter.hpp"
 
 QT_BEGIN_NAMESPACE
 class QSvgGenerator;
@@ -44,7 +45,7 @@ class Exporter;
 
 class ExporterPrivate {
 public:
-	ExporterPrivate( const Cfg::Project & cfg, Exporter * parent );
+	ExporterPrivate( const ProjectSnapshot & cfg, Exporter * parent );
 	virtual ~ExporterPrivate() = default;
 
 	//! Init.
@@ -54,8 +55,10 @@ public:
 
 	//! Parent.
 	Exporter * q;
+	//! Snapshot of the project.
+	ProjectSnapshot m_snapshot;
 	//! Cfg.
-	Cfg::Project m_cfg;
+	const Cfg::Project & m_cfg;
 }; // class ExporterPrivate
 
 } /* namespace Core */
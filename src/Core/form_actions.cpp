@@ -23,6 +23,7 @@
 // Prototyper include.
 #include "form_actions.hpp"
 #include "page.hpp"
+#include "constants.hpp"
 
 // Qt include.
 #include <QApplication>
@@ -46,6 +47,11 @@ public:
 		,	m_fillColor( Qt::transparent )
 		,	m_strokeColor( Qt::black )
 		,	m_snap( true )
+		,	m_objectSnap( true )
+		,	m_renderCache( true )
+		,	m_simplifyPolylines( false )
+		,	m_undoHistory( false )
+		,	m_maxImageSize( c_maxImageSize )
 	{
 	}
 
@@ -61,6 +67,16 @@ public:
 	QColor m_strokeColor;
 	//! Is snap enabled?
 	bool m_snap;
+	//! Is snap to objects enabled?
+	bool m_objectSnap;
+	//! Is raster cache of static items enabled?
+	bool m_renderCache;
+	//! Simplify finished polylines.
+	bool m_simplifyPolylines;
+	//! Save undo history.
+	bool m_undoHistory;
+	//! Max size of imported images.
+	int m_maxImageSize;
 	//! Flags.
 	PageAction::Flags m_flags;
 }; // class FormActionPrivate
@@ -190,6 +206,66 @@ PageAction::enableSnap( bool on )
 	d->m_snap = on;
 }
 
+bool
+PageAction::isObjectSnapEnabled() const
+{
+	return d->m_objectSnap;
+}
+
+void
+PageAction::enableObjectSnap( bool on )
+{
+	d->m_objectSnap = on;
+}
+
+int
+PageAction::maxImageSize() const
+{
+	return d->m_maxImageSize;
+}
+
+void
+PageAction::setMaxImageSize( int s )
+{
+	d->m_maxImageSize = s;
+}
+
+bool
+PageAction::isRenderCacheEnabled() const
+{
+	return d->m_renderCache;
+}
+
+void
+PageAction::enableRenderCache( bool on )
+{
+	d->m_renderCache = on;
+}
+
+bool
+PageAction::isPolylineSimplificationEnabled() const
+{
+	return d->m_simplifyPolylines;
+}
+
+void
+PageAction::enablePolylineSimplification( bool on )
+{
+	d->m_simplifyPolylines = on;
+}
+
+bool
+PageAction::isUndoHistoryPersistent() const
+{
+	return d->m_undoHistory;
+}
+
+void
+PageAction::enableUndoHistoryPersistence( bool on )
+{
+	d->m_undoHistory = on;
+}
+
 } /* namespace Core */
 
 } /*  namespace Prototyper */
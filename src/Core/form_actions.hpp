@@ -130,6 +130,31 @@ public:
 	//! Enable/disable snap to grid.
 	void enableSnap( bool on = true );
 
+	//! Is snap to edges and centers of objects enabled?
+	bool isObjectSnapEnabled() const;
+	//! Enable/disable snap to edges and centers of objects.
+	void enableObjectSnap( bool on = true );
+
+	//! \return Max width and height of imported images, 0 for no limit.
+	int maxImageSize() const;
+	//! Set max width and height of imported images.
+	void setMaxImageSize( int s );
+
+	//! Is raster cache of static items enabled?
+	bool isRenderCacheEnabled() const;
+	//! Enable/disable raster cache of static items.
+	void enableRenderCache( bool on = true );
+
+	//! Is polyline simplified when it's finished?
+	bool isPolylineSimplificationEnabled() const;
+	//! Enable/disable simplification of finished polylines.
+	void enablePolylineSimplification( bool on = true );
+
+	//! Is undo history saved with the project?
+	bool isUndoHistoryPersistent() const;
+	//! Enable/disable saving of undo history with the project.
+	void enableUndoHistoryPersistence( bool on = true );
+
 private:
 	Q_DISABLE_COPY( PageAction )
 
@@ -23,6 +23,7 @@
 // Prototyper include.
 #include "form_aspect_ratio_handle.hpp"
 #include "constants.hpp"
+#include "page.hpp"
 
 // Qt include.
 #include <QPainter>
@@ -41,8 +42,9 @@ namespace Core {
 
 class AspectRatioHandlePrivate {
 public:
-	explicit AspectRatioHandlePrivate( AspectRatioHandle * parent )
+	AspectRatioHandlePrivate( AspectRatioHandle * parent, Page * form )
 		:	q( parent )
+		,	m_form( form )
 		,	m_keepAspectRatio( true )
 		,	m_hovered( false )
 		,	m_pressed( false )
@@ -54,6 +56,8 @@ public:
 
 	//! Parent.
 	AspectRatioHandle * q;
+	//! Form.
+	Page * m_form;
 	//! Keep aspect ratio?
 	bool m_keepAspectRatio;
 	//! Hovered?
@@ -75,9 +79,9 @@ AspectRatioHandlePrivate::init()
 // AspectRatioHandle
 //
 
-AspectRatioHandle::AspectRatioHandle( QGraphicsItem * parent )
+AspectRatioHandle::AspectRatioHandle( QGraphicsItem * parent, Page * form )
 	:	QGraphicsItem( parent )
-	,	d( new AspectRatioHandlePrivate( this ) )
+	,	d( new AspectRatioHandlePrivate( this, form ) )
 {
 	d->init();
 }
@@ -196,6 +200,9 @@ AspectRatioHandle::mouseReleaseEvent( QGraphicsSceneMouseEvent * event )
 
 			update();
 
+			if( d->m_form )
+				d->m_form->emitChanged();
+
 			event->accept();
 
 			return;
@@ -37,13 +37,14 @@ namespace Core {
 //
 
 class AspectRatioHandlePrivate;
+class Page;
 
 //! Aspect ratio handle.
 class AspectRatioHandle final
 	:	public QGraphicsItem
 {
 public:
-	explicit AspectRatioHandle( QGraphicsItem * parent );
+	AspectRatioHandle( QGraphicsItem * parent, Page * form );
 	~AspectRatioHandle() override;
 
 	//! \return Is keep aspect ratio?
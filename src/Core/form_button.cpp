@@ -114,11 +114,15 @@ FormButtonPrivate::init()
 		false );
 
 	q->setObjectBrush( QBrush( PageAction::instance()->fillColor() ), false );
+
+	updateRenderCache( q, false );
 }
 
 void
 FormButtonPrivate::setRect( const QRectF & rect )
 {
+	q->prepareGeometryChange();
+
 	m_rect = rect;
 
 	q->setPos( m_rect.topLeft() );
@@ -173,17 +177,21 @@ FormButton::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	Q_UNUSED( widget )
 	Q_UNUSED( option )
 
-	painter->setPen( objectPen() );
-	painter->setFont( d->m_font );
-	painter->setBrush( objectBrush() );
+	const qreal lod = levelOfDetail( painter );
 
-	painter->drawRect( d->m_rect );
-	painter->drawText( d->m_rect, Qt::AlignCenter, d->m_text );
-
-	if( isSelected() && !group() )
-		d->m_proxy->show();
+	if( isLowDetail( lod, qMin( d->m_rect.width(), d->m_rect.height() ) ) )
+		drawLowDetail( painter, d->m_rect, objectPen(), objectBrush() );
 	else
-		d->m_proxy->hide();
+	{
+		painter->setPen( objectPen() );
+		painter->setFont( d->m_font );
+		painter->setBrush( objectBrush() );
+
+		painter->drawRect( d->m_rect );
+
+		if( !isLowDetail( lod, d->m_font.pixelSize(), c_lodMinTextSize ) )
+			painter->drawText( d->m_rect, Qt::AlignCenter, d->m_text );
+	}
 }
 
 void
@@ -221,7 +229,7 @@ FormButton::cfg() const
 
 	c.set_size( s );
 
-	c.set_text( text() );
+	c.set_text( Cfg::textStyle( text() ) );
 
 	c.set_pen( Cfg::pen( objectPen() ) );
 	c.set_brush( Cfg::brush( objectBrush() ) );
@@ -242,63 +250,37 @@ FormButton::setCfg( const Cfg::Button & c )
 		MmPx::instance().fromMmX( c.size().width() ),
 		MmPx::instance().fromMmY( c.size().height() ) ) );
 
-	setText( c.text() );
+	setText( Cfg::textRun( c.text() ) );
 
 	setZValue( c.z() );
 
 	update();
 }
 
-Cfg::TextStyle
+Cfg::TextRun
 FormButton::text() const
 {
-	Cfg::TextStyle textStyle = Cfg::textStyleFromFont( d->m_font );
-	textStyle.style().push_back( Cfg::c_center );
-	textStyle.set_text( d->m_text );
+	Cfg::TextRun run = Cfg::textRunFromFont( d->m_font );
+	run.m_style |= Cfg::CenterAlignment;
+	run.m_text = d->m_text;
 
-	return textStyle;
+	return run;
 }
 
 void
-FormButton::setText( const Cfg::TextStyle & c )
+FormButton::setText( const Cfg::TextRun & c )
 {
-	if( std::find( c.style().cbegin(), c.style().cend(),
-		Cfg::c_normalStyle ) != c.style().cend() )
-	{
-		d->m_font.setWeight( QFont::Normal );
-		d->m_font.setItalic( false );
-		d->m_font.setUnderline( false );
-	}
-	else
-	{
-		if( std::find( c.style().cbegin(), c.style().cend(),
-			Cfg::c_boldStyle ) != c.style().cend() )
-				d->m_font.setWeight( QFont::Bold );
-		else
-			d->m_font.setWeight( QFont::Normal );
-
-		if( std::find( c.style().cbegin(), c.style().cend(),
-			Cfg::c_italicStyle ) != c.style().cend() )
-				d->m_font.setItalic( true );
-		else
-			d->m_font.setItalic( false );
-
-		if( std::find( c.style().cbegin(), c.style().cend(),
-			Cfg::c_underlineStyle ) != c.style().cend() )
-				d->m_font.setUnderline( true );
-		else
-			d->m_font.setUnderline( false );
-	}
+	Cfg::initFont( d->m_font, c.m_style );
 
-	d->m_font.setPixelSize( MmPx::instance().fromPtY( c.fontSize() ) );
+	d->m_font.setPixelSize( MmPx::instance().fromPtY( c.m_fontSize ) );
 
-	d->m_text = c.text();
+	d->m_text = c.m_text;
 
 	if( d->m_props )
 	{
 		d->disconnectProperties();
 		d->m_textProps->ui()->m_text->setText( d->m_text );
-		d->m_textStyleProps->ui()->m_size->setValue( qRound( c.fontSize() ) );
+		d->m_textStyleProps->ui()->m_size->setValue( qRound( c.m_fontSize ) );
 		d->m_textStyleProps->ui()->m_bold->setChecked( d->m_font.weight() == QFont::Bold );
 		d->m_textStyleProps->ui()->m_italic->setChecked( d->m_font.italic() );
 		d->m_textStyleProps->ui()->m_underline->setChecked( d->m_font.underline() );
@@ -380,6 +362,19 @@ FormButton::moveResizable( const QPointF & delta )
 	moveBy( delta.x(), delta.y() );
 }
 
+QVariant
+FormButton::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemSelectedHasChanged )
+	{
+		updateRenderCache( this, value.toBool() );
+
+		d->m_proxy->setVisible( value.toBool() && !group() );
+	}
+
+	return QGraphicsObject::itemChange( change, value );
+}
+
 QSizeF
 FormButton::defaultSize() const
 {
@@ -387,20 +382,32 @@ FormButton::defaultSize() const
 }
 
 QWidget *
-FormButton::properties( QWidget * parent )
+FormButton::properties( QWidget * parent, QWidget * panel )
 {
-	d->m_props = new QWidget( parent );
-	d->m_objProps = new ObjectProperties( this, d->m_props );
-	d->m_textProps = new TextProperties( d->m_props );
-	d->m_textStyleProps = new TextStyleProperties( d->m_props );
-
-	QVBoxLayout * l = new QVBoxLayout( d->m_props );
-	l->setMargin( 0 );
-	l->setSpacing( 0 );
-	l->addWidget( d->m_objProps );
-	l->addWidget( d->m_textProps );
-	l->addWidget( d->m_textStyleProps );
-	l->addSpacerItem( new QSpacerItem( 0, 0, QSizePolicy::Minimum, QSizePolicy::Expanding ) );
+	if( panel )
+	{
+		d->m_props = panel;
+		d->m_objProps = panel->findChild< ObjectProperties* > ();
+		d->m_objProps->setObject( this );
+		d->m_textProps = panel->findChild< TextProperties* > ();
+		d->m_textStyleProps = panel->findChild< TextStyleProperties* > ();
+		d->disconnectProperties();
+	}
+	else
+	{
+		d->m_props = new QWidget( parent );
+		d->m_objProps = new ObjectProperties( this, d->m_props );
+		d->m_textProps = new TextProperties( d->m_props );
+		d->m_textStyleProps = new TextStyleProperties( d->m_props );
+
+		QVBoxLayout * l = new QVBoxLayout( d->m_props );
+		l->setMargin( 0 );
+		l->setSpacing( 0 );
+		l->addWidget( d->m_objProps );
+		l->addWidget( d->m_textProps );
+		l->addWidget( d->m_textStyleProps );
+		l->addSpacerItem( new QSpacerItem( 0, 0, QSizePolicy::Minimum, QSizePolicy::Expanding ) );
+	}
 
 	d->m_objProps->ui()->m_x->setValue( pos().x() );
 	d->m_objProps->ui()->m_y->setValue( pos().y() );
@@ -420,6 +427,17 @@ FormButton::properties( QWidget * parent )
 	return d->m_props.data();
 }
 
+void
+FormButton::releaseProperties()
+{
+	d->disconnectProperties();
+
+	d->m_props = nullptr;
+	d->m_objProps = nullptr;
+	d->m_textProps = nullptr;
+	d->m_textStyleProps = nullptr;
+}
+
 void
 FormButton::updatePropertiesValues()
 {
@@ -435,9 +453,10 @@ FormButton::updatePropertiesValues()
 }
 
 FormObject *
-FormButton::clone() const
+FormButton::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormButton( rectangle(), page(), parentItem() );
+	auto * o = new FormButton( rectangle(), page(),
+		( parent ? parent : parentItem() ) );
 
 	o->setCfg( cfg() );
 
@@ -37,6 +37,12 @@ namespace Prototyper {
 
 namespace Core {
 
+namespace Cfg {
+
+struct TextRun;
+
+} /* namespace Cfg */
+
 class TextWithOpts;
 
 
@@ -76,9 +82,9 @@ public:
 	void setCfg( const Cfg::Button & c );
 
 	//! \return Text.
-	Cfg::TextStyle text() const;
+	Cfg::TextRun text() const;
 	//! Set text.
-	void setText( const Cfg::TextStyle & c );
+	void setText( const Cfg::TextRun & c );
 
 	QRectF boundingRect() const override;
 
@@ -95,11 +101,12 @@ public:
 	//! \return Default size.
 	virtual QSizeF defaultSize() const override;
 
-	QWidget * properties( QWidget * parent ) override;
+	QWidget * properties( QWidget * parent, QWidget * panel ) override;
+	void releaseProperties() override;
 	void updatePropertiesValues() override;
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 protected:
 	//! Resize.
@@ -107,6 +114,9 @@ protected:
 	//! Move resizable.
 	void moveResizable( const QPointF & delta ) override;
 
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
+
 private:
 	friend class FormButtonPrivate;
 
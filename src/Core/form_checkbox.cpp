@@ -89,11 +89,15 @@ FormCheckBoxPrivate::init()
 		false );
 
 	q->setObjectBrush( QBrush( PageAction::instance()->fillColor() ), false );
+
+	updateRenderCache( q, false );
 }
 
 void
 FormCheckBoxPrivate::setRect( const QRectF & rect )
 {
+	q->prepareGeometryChange();
+
 	const QRectF r = rect;
 
 	m_rect = QRectF( 0.0, 0.0, FormCheckBox::boxHeight(), rect.height() );
@@ -166,20 +170,21 @@ FormCheckBox::paint( QPainter * painter, const QStyleOptionGraphicsItem * option
 
 	painter->setClipRect( boundingRect() );
 
-	draw( painter,
-		objectPen(),
-		objectBrush(),
-		d->m_font,
-		QRectF( 0.0, 0.0, d->m_rect.width(), d->m_rect.height() ),
-		d->m_width,
-		d->m_checked,
-		d->m_text,
-		boundingRect() );
-
-	if( isSelected() && !group() )
-		d->m_handles->show();
+	const qreal lod = levelOfDetail( painter );
+
+	if( isLowDetail( lod, d->m_rect.height() ) )
+		drawLowDetail( painter, d->m_rect, objectPen(), objectBrush() );
 	else
-		d->m_handles->hide();
+		draw( painter,
+			objectPen(),
+			objectBrush(),
+			d->m_font,
+			QRectF( 0.0, 0.0, d->m_rect.width(), d->m_rect.height() ),
+			d->m_width,
+			d->m_checked,
+			( isLowDetail( lod, d->m_font.pixelSize(), c_lodMinTextSize ) ?
+				QString() : d->m_text ),
+			boundingRect() );
 }
 
 void
@@ -277,7 +282,7 @@ FormCheckBox::cfg() const
 
 	c.set_size( s );
 
-	c.set_text( text() );
+	c.set_text( Cfg::textStyle( text() ) );
 
 	c.set_z( zValue() );
 
@@ -298,63 +303,39 @@ FormCheckBox::setCfg( const Cfg::CheckBox & c )
 		MmPx::instance().fromMmX( c.width() ),
 		MmPx::instance().fromMmY( c.size().height() ) ) );
 
-	setText( c.text() );
+	setText( Cfg::textRun( c.text() ) );
 
 	setZValue( c.z() );
 
 	update();
 }
 
-Cfg::TextStyle
+Cfg::TextRun
 FormCheckBox::text() const
 {
-	Cfg::TextStyle textStyle = Cfg::textStyleFromFont( d->m_font );
-	textStyle.style().push_back( Cfg::c_left );
-	textStyle.set_text( d->m_text );
+	Cfg::TextRun run = Cfg::textRunFromFont( d->m_font );
+	run.m_style |= Cfg::LeftAlignment;
+	run.m_text = d->m_text;
 
-	return textStyle;
+	return run;
 }
 
 void
-FormCheckBox::setText( const Cfg::TextStyle & c )
+FormCheckBox::setText( const Cfg::TextRun & c )
 {
-	if( std::find( c.style().cbegin(), c.style().cend(),
-		Cfg::c_normalStyle ) != c.style().cend() )
-	{
-		d->m_font.setWeight( QFont::Normal );
-		d->m_font.setItalic( false );
-		d->m_font.setUnderline( false );
-	}
-	else
-	{
-		if( std::find( c.style().cbegin(), c.style().cend(),
-			Cfg::c_boldStyle ) != c.style().cend() )
-				d->m_font.setWeight( QFont::Bold );
-		else
-			d->m_font.setWeight( QFont::Normal );
-
-		if( std::find( c.style().cbegin(), c.style().cend(),
-			Cfg::c_italicStyle ) != c.style().cend() )
-				d->m_font.setItalic( true );
-		else
-			d->m_font.setItalic( false );
-
-		if( std::find( c.style().cbegin(), c.style().cend(),
-			Cfg::c_underlineStyle ) != c.style().cend() )
-				d->m_font.setUnderline( true );
-		else
-			d->m_font.setUnderline( false );
-	}
+	prepareGeometryChange();
+
+	Cfg::initFont( d->m_font, c.m_style );
 
-	d->m_font.setPixelSize( MmPx::instance().fromPtY( c.fontSize() ) );
+	d->m_font.setPixelSize( MmPx::instance().fromPtY( c.m_fontSize ) );
 
-	d->m_text = c.text();
+	d->m_text = c.m_text;
 
 	if( d->m_props )
 	{
 		d->disconnectProperties();
 		d->m_textProps->ui()->m_text->setText( d->m_text );
-		d->m_textStyleProps->ui()->m_size->setValue( qRound( c.fontSize() ) );
+		d->m_textStyleProps->ui()->m_size->setValue( qRound( c.m_fontSize ) );
 		d->m_textStyleProps->ui()->m_bold->setChecked( d->m_font.weight() == QFont::Bold );
 		d->m_textStyleProps->ui()->m_italic->setChecked( d->m_font.italic() );
 		d->m_textStyleProps->ui()->m_underline->setChecked( d->m_font.underline() );
@@ -459,6 +440,19 @@ FormCheckBox::moveResizable( const QPointF & delta )
 	moveBy( delta.x(), delta.y() );
 }
 
+QVariant
+FormCheckBox::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemSelectedHasChanged )
+	{
+		updateRenderCache( this, value.toBool() );
+
+		d->m_handles->setVisible( value.toBool() && !group() );
+	}
+
+	return QGraphicsObject::itemChange( change, value );
+}
+
 QSizeF
 FormCheckBox::defaultSize() const
 {
@@ -472,22 +466,35 @@ FormCheckBox::minimumSize() const
 }
 
 QWidget *
-FormCheckBox::properties( QWidget * parent )
-{
-	d->m_props = new QWidget( parent );
-	d->m_objProps = new ObjectProperties( this, d->m_props );
-	d->m_textProps = new TextProperties( d->m_props );
-	d->m_textStyleProps = new TextStyleProperties( d->m_props );
-	d->m_checkProps = new CheckBoxProperties( d->m_props );
-
-	QVBoxLayout * l = new QVBoxLayout( d->m_props );
-	l->setMargin( 0 );
-	l->setSpacing( 0 );
-	l->addWidget( d->m_objProps );
-	l->addWidget( d->m_textProps );
-	l->addWidget( d->m_textStyleProps );
-	l->addWidget( d->m_checkProps );
-	l->addSpacerItem( new QSpacerItem( 0, 0, QSizePolicy::Minimum, QSizePolicy::Expanding ) );
+FormCheckBox::properties( QWidget * parent, QWidget * panel )
+{
+	if( panel )
+	{
+		d->m_props = panel;
+		d->m_objProps = panel->findChild< ObjectProperties* > ();
+		d->m_objProps->setObject( this );
+		d->m_textProps = panel->findChild< TextProperties* > ();
+		d->m_textStyleProps = panel->findChild< TextStyleProperties* > ();
+		d->m_checkProps = panel->findChild< CheckBoxProperties* > ();
+		d->disconnectProperties();
+	}
+	else
+	{
+		d->m_props = new QWidget( parent );
+		d->m_objProps = new ObjectProperties( this, d->m_props );
+		d->m_textProps = new TextProperties( d->m_props );
+		d->m_textStyleProps = new TextStyleProperties( d->m_props );
+		d->m_checkProps = new CheckBoxProperties( d->m_props );
+
+		QVBoxLayout * l = new QVBoxLayout( d->m_props );
+		l->setMargin( 0 );
+		l->setSpacing( 0 );
+		l->addWidget( d->m_objProps );
+		l->addWidget( d->m_textProps );
+		l->addWidget( d->m_textStyleProps );
+		l->addWidget( d->m_checkProps );
+		l->addSpacerItem( new QSpacerItem( 0, 0, QSizePolicy::Minimum, QSizePolicy::Expanding ) );
+	}
 
 	d->m_objProps->ui()->m_x->setValue( pos().x() );
 	d->m_objProps->ui()->m_y->setValue( pos().y() );
@@ -512,6 +519,18 @@ FormCheckBox::properties( QWidget * parent )
 	return d->m_props.data();
 }
 
+void
+FormCheckBox::releaseProperties()
+{
+	d->disconnectProperties();
+
+	d->m_props = nullptr;
+	d->m_objProps = nullptr;
+	d->m_textProps = nullptr;
+	d->m_textStyleProps = nullptr;
+	d->m_checkProps = nullptr;
+}
+
 void
 FormCheckBox::updatePropertiesValues()
 {
@@ -554,9 +573,10 @@ FormCheckBox::setChecked( bool on )
 }
 
 FormObject *
-FormCheckBox::clone() const
+FormCheckBox::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormCheckBox( rectangle(), page(), parentItem() );
+	auto * o = new FormCheckBox( rectangle(), page(),
+		( parent ? parent : parentItem() ) );
 
 	o->setCfg( cfg() );
 
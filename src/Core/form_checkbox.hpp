@@ -38,6 +38,12 @@ namespace Prototyper {
 
 namespace Core {
 
+namespace Cfg {
+
+struct TextRun;
+
+} /* namespace Cfg */
+
 class FormCheckBox;
 class FormImageHandles;
 class TextWithOpts;
@@ -85,9 +91,9 @@ public:
 	void setCfg( const Cfg::CheckBox & c );
 
 	//! \return Text.
-	Cfg::TextStyle text() const;
+	Cfg::TextRun text() const;
 	//! Set text.
-	void setText( const Cfg::TextStyle & c );
+	void setText( const Cfg::TextRun & c );
 
 	QRectF boundingRect() const override;
 
@@ -106,7 +112,8 @@ public:
 	//! \return Minimum allowed size.
 	QSizeF minimumSize() const override;
 
-	QWidget * properties( QWidget * parent ) override;
+	QWidget * properties( QWidget * parent, QWidget * panel ) override;
+	void releaseProperties() override;
 	void updatePropertiesValues() override;
 
 	virtual QString typeName() const;
@@ -117,7 +124,7 @@ public:
 	void setChecked( bool on = true );
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 protected:
 	//! Resize.
@@ -125,6 +132,9 @@ protected:
 	//! Move resizable.
 	void moveResizable( const QPointF & delta ) override;
 
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
+
 protected:
 	FormCheckBox( const QRectF & rect, Page * page,
 		FormObject::ObjectType type, QGraphicsItem * parent = 0 );
@@ -134,6 +144,7 @@ protected:
 
 private:
 	friend class FormButtonPrivate;
+	friend class FormCheckBoxPrivate;
 
 	Q_DISABLE_COPY( FormCheckBox )
 }; // class FormCheckBox
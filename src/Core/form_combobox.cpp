@@ -78,11 +78,15 @@ FormComboBoxPrivate::init()
 		false );
 
 	q->setObjectBrush( QBrush( PageAction::instance()->fillColor() ), false );
+
+	updateRenderCache( q, false );
 }
 
 void
 FormComboBoxPrivate::setRect( const QRectF & rect )
 {
+	q->prepareGeometryChange();
+
 	m_rect = rect;
 
 	q->setPos( m_rect.topLeft() );
@@ -115,12 +119,11 @@ FormComboBox::paint( QPainter * painter, const QStyleOptionGraphicsItem * option
 	Q_UNUSED( widget )
 	Q_UNUSED( option )
 
-	draw( painter, d->m_rect, objectPen(), objectBrush() );
-
-	if( isSelected() && !group() )
-		d->m_proxy->show();
+	if( isLowDetail( levelOfDetail( painter ),
+		qMin( d->m_rect.width(), d->m_rect.height() ) ) )
+			drawLowDetail( painter, d->m_rect, objectPen(), objectBrush() );
 	else
-		d->m_proxy->hide();
+		draw( painter, d->m_rect, objectPen(), objectBrush() );
 }
 
 void
@@ -284,6 +287,19 @@ FormComboBox::moveResizable( const QPointF & delta )
 	moveBy( delta.x(), delta.y() );
 }
 
+QVariant
+FormComboBox::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemSelectedHasChanged )
+	{
+		updateRenderCache( this, value.toBool() );
+
+		d->m_proxy->setVisible( value.toBool() && !group() );
+	}
+
+	return QGraphicsItem::itemChange( change, value );
+}
+
 QSizeF
 FormComboBox::defaultSize() const
 {
@@ -291,9 +307,10 @@ FormComboBox::defaultSize() const
 }
 
 FormObject *
-FormComboBox::clone() const
+FormComboBox::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormComboBox( rectangle(), page(), parentItem() );
+	auto * o = new FormComboBox( rectangle(), page(),
+		( parent ? parent : parentItem() ) );
 
 	o->setCfg( cfg() );
 
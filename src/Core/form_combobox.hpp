@@ -91,7 +91,7 @@ public:
 	virtual QSizeF defaultSize() const override;
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 protected:
 	//! Resize.
@@ -99,6 +99,9 @@ protected:
 	//! Move resizable.
 	void moveResizable( const QPointF & delta ) override;
 
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
+
 private:
 	friend class FormComboBoxPrivate;
 
@@ -22,6 +22,8 @@
 
 // Prototyper include.
 #include "form_grid_snap.hpp"
+#include "form_object_snap.hpp"
+#include "form_actions.hpp"
 #include "constants.hpp"
 
 // Qt include.
@@ -44,6 +46,7 @@ public:
 		:	q( parent )
 		,	m_step( 10.0 )
 		,	m_size( c_snapHalfSize )
+		,	m_objects( nullptr )
 	{
 	}
 
@@ -62,6 +65,10 @@ public:
 	QPointF m_pos;
 	//! Size.
 	const int m_size;
+	//! Snap to objects.
+	ObjectSnap * m_objects;
+	//! Alignment guides in local coordinates.
+	QVector< QLineF > m_guides;
 }; // class GridSnapPrivate
 
 void
@@ -85,9 +92,25 @@ GridSnapPrivate::calc( const QPointF & p )
 void
 GridSnapPrivate::calc()
 {
-	m_pos = calc( m_pos );
+	QVector< QLineF > guides;
+
+	if( m_objects && PageAction::instance()->isObjectSnapEnabled() )
+		m_pos = m_objects->snapped( m_pos, calc( m_pos ),
+			c_objectSnapTolerance, guides );
+	else
+		m_pos = calc( m_pos );
 
 	q->setPos( m_pos - QPointF( m_size, m_size ) );
+
+	for( auto & g : guides )
+		g.translate( -q->pos() );
+
+	if( guides != m_guides )
+	{
+		q->prepareGeometryChange();
+
+		m_guides = guides;
+	}
 }
 
 
@@ -136,11 +159,25 @@ GridSnap::snapped( const QPointF & p ) const
 	return d->calc( p );
 }
 
+void
+GridSnap::setObjectSnap( ObjectSnap * s )
+{
+	d->m_objects = s;
+}
+
 QRectF
 GridSnap::boundingRect() const
 {
 	if( !d.isNull() )
-		return { 0, 0, d->m_size * c_halfDivider, d->m_size * c_halfDivider };
+	{
+		QRectF r( 0, 0, d->m_size * c_halfDivider, d->m_size * c_halfDivider );
+
+		for( const auto & g : qAsConst( d->m_guides ) )
+			r |= QRectF( g.p1(), g.p2() ).normalized().adjusted(
+				-1.0, -1.0, 1.0, 1.0 );
+
+		return r;
+	}
 
 	return {};
 }
@@ -150,14 +187,19 @@ GridSnap::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	QWidget * widget )
 {
 	Q_UNUSED( widget )
+	Q_UNUSED( option )
+
+	const qreal size = d->m_size * c_halfDivider;
 
 	painter->setPen( Qt::gray );
-	painter->drawLine( option->rect.x(), option->rect.y(),
-		option->rect.x() + option->rect.width(),
-		option->rect.y() + option->rect.height() );
-	painter->drawLine( option->rect.x() + option->rect.width(),
-		option->rect.y(), option->rect.x(),
-		option->rect.y() + option->rect.height() );
+	painter->drawLine( QPointF( 0.0, 0.0 ), QPointF( size, size ) );
+	painter->drawLine( QPointF( size, 0.0 ), QPointF( 0.0, size ) );
+
+	if( !d->m_guides.isEmpty() )
+	{
+		painter->setPen( QPen( c_snapGuideColor, 0.0, Qt::DashLine ) );
+		painter->drawLines( d->m_guides );
+	}
 }
 
 void
@@ -32,6 +32,9 @@ namespace Prototyper {
 
 namespace Core {
 
+class ObjectSnap;
+
+
 //
 // GridSnap
 //
@@ -57,6 +60,9 @@ public:
 	//! \return Point snapped to grid.
 	QPointF snapped( const QPointF & p ) const;
 
+	//! Set snap to objects.
+	void setObjectSnap( ObjectSnap * s );
+
 	QRectF boundingRect() const override;
 
 	void paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
@@ -68,6 +74,8 @@ protected:
 	void mouseReleaseEvent( QGraphicsSceneMouseEvent * event ) override;
 
 private:
+	friend class GridSnapPrivate;
+
 	Q_DISABLE_COPY( GridSnap )
 
 	QScopedPointer< GridSnapPrivate > d;
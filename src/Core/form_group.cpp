@@ -73,8 +73,14 @@ public:
 	{
 	}
 
-	//! Init.
-	void init();
+	//! Create handles.
+	void createHandles();
+	//! Release handles if they are not in use.
+	void releaseHandles();
+	//! Place handles around the group if they are created.
+	void placeHandles();
+	//! Show or release handles depending on selection.
+	void updateHandles();
 
 	//! Parent.
 	FormGroup * q;
@@ -97,8 +103,11 @@ public:
 }; // class FormGroupPrivate
 
 void
-FormGroupPrivate::init()
+FormGroupPrivate::createHandles()
 {
+	if( m_center )
+		return;
+
 	m_center.reset( new FormMoveHandle( c_halfHandleSize,
 		QPointF( c_halfHandleSize, c_halfHandleSize ), q,
 		q->parentItem(), q->page(), Qt::SizeAllCursor ) );
@@ -129,6 +138,81 @@ FormGroupPrivate::init()
 	m_bottomLeft->hide();
 }
 
+void
+FormGroupPrivate::releaseHandles()
+{
+	if( !m_center )
+		return;
+
+	const QGraphicsItem * grabber = ( q->scene() ?
+		q->scene()->mouseGrabberItem() : nullptr );
+
+	if( grabber && ( grabber == m_center.data() ||
+		grabber == m_topLeft.data() || grabber == m_topRight.data() ||
+		grabber == m_bottomRight.data() || grabber == m_bottomLeft.data() ) )
+	{
+		m_center->hide();
+		m_topLeft->hide();
+		m_topRight->hide();
+		m_bottomRight->hide();
+		m_bottomLeft->hide();
+	}
+	else
+	{
+		m_center.reset();
+		m_topLeft.reset();
+		m_topRight.reset();
+		m_bottomRight.reset();
+		m_bottomLeft.reset();
+	}
+}
+
+void
+FormGroupPrivate::placeHandles()
+{
+	if( !m_center )
+		return;
+
+	const QRectF r = q->boundingRect();
+
+	m_center->setPos( q->mapToParent(
+		r.x() + r.width() / 2.0 - m_center->halfOfSize(),
+		r.y() + r.height() / 2.0 - m_center->halfOfSize() ) );
+
+	m_topLeft->setPos( q->mapToParent( r.topLeft() ) );
+
+	m_topRight->setPos( q->mapToParent(
+		r.x() + r.width() - m_topRight->halfOfSize() * 2.0,
+		r.y() ) );
+
+	m_bottomRight->setPos( q->mapToParent(
+		r.x() + r.width() - m_bottomRight->halfOfSize() * 2.0,
+		r.y() + r.height() - m_bottomRight->halfOfSize() * 2.0 ) );
+
+	m_bottomLeft->setPos( q->mapToParent(
+		r.x(),
+		r.y() + r.height() - m_bottomLeft->halfOfSize() * 2.0 ) );
+}
+
+void
+FormGroupPrivate::updateHandles()
+{
+	if( q->isSelected() && !q->group() )
+	{
+		createHandles();
+
+		placeHandles();
+
+		m_center->show();
+		m_topLeft->show();
+		m_topRight->show();
+		m_bottomRight->show();
+		m_bottomLeft->show();
+	}
+	else
+		releaseHandles();
+}
+
 
 //
 // FormGroup
@@ -139,7 +223,6 @@ FormGroup::FormGroup( Page * page, QGraphicsItem * parent )
 	,	FormObject( FormObject::GroupType, page, 0 )
 	,	d( new FormGroupPrivate( this ) )
 {
-	d->init();
 }
 
 FormGroup::~FormGroup() = default;
@@ -415,56 +498,16 @@ FormGroup::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 		painter->setBrush( Qt::NoBrush );
 
 		painter->drawRect( option->rect );
+	}
+}
 
-		const QPointF p( option->rect.x() + option->rect.width() / 2.0 -
-				 d->m_center->halfOfSize(),
-			 option->rect.y() + option->rect.height() / 2.0 -
-				 d->m_center->halfOfSize() );
-
-		d->m_center->setPos( mapToParent( p ) );
-
-		d->m_center->show();
-
-		const QPointF p1( option->rect.x(),
-			 option->rect.y() );
-
-		d->m_topLeft->setPos( mapToParent( p1 ) );
-
-		d->m_topLeft->show();
-
-		const QPointF p2( option->rect.x() + option->rect.width() -
-				 d->m_topRight->halfOfSize() * 2.0,
-			 option->rect.y() );
-
-		d->m_topRight->setPos( mapToParent( p2 ) );
-
-		d->m_topRight->show();
-
-		const QPointF p3( option->rect.x() + option->rect.width() -
-				 d->m_bottomRight->halfOfSize() * 2.0,
-			 option->rect.y() + option->rect.height() -
-				 d->m_bottomRight->halfOfSize() * 2.0 );
-
-		d->m_bottomRight->setPos( mapToParent( p3 ) );
-
-		d->m_bottomRight->show();
-
-		const QPointF p4( option->rect.x(),
-			 option->rect.y() + option->rect.height() -
-				 d->m_bottomLeft->halfOfSize() * 2.0 );
-
-		d->m_bottomLeft->setPos( mapToParent( p4 ) );
+QVariant
+FormGroup::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemSelectedHasChanged )
+		d->updateHandles();
 
-		d->m_bottomLeft->show();
-	}
-	else
-	{
-		d->m_center->hide();
-		d->m_topLeft->hide();
-		d->m_topRight->hide();
-		d->m_bottomRight->hide();
-		d->m_bottomLeft->hide();
-	}
+	return QGraphicsItemGroup::itemChange( change, value );
 }
 
 void
@@ -474,6 +517,8 @@ FormGroup::setPosition( const QPointF & pos, bool pushUndoCommand )
 
 	setPos( pos - QGraphicsItemGroup::boundingRect().topLeft() );
 
+	d->placeHandles();
+
 	update();
 }
 
@@ -511,6 +556,8 @@ FormGroup::handleMoved( const QPointF & delta, FormMoveHandle * handle )
 	}
 
 	moveBy( delta.x(), delta.y() );
+
+	d->placeHandles();
 }
 
 void
@@ -542,18 +589,28 @@ FormGroup::createElemWithRect( const Config & cfg )
 }
 
 FormObject *
-FormGroup::clone() const
+FormGroup::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormGroup( page(), parentItem() );
+	auto * o = new FormGroup( page(), ( parent ? parent : parentItem() ) );
+
+	// Children are cloned onto the page with their positions in the group
+	// and then added to the group, as setCfg() does.
+	const auto ch = children();
 
-	o->setCfg( cfg() );
+	for( const auto & i : ch )
+	{
+		auto * c = dynamic_cast< QGraphicsItem* > (
+			dynamic_cast< FormObject* > ( i )->clone( page() ) );
+
+		if( c )
+			o->addToGroup( c );
+	}
 
 	o->setObjectId( page()->nextId() );
 
-	const auto ch = o->children();
+	o->setZValue( zValue() );
 
-	for( const auto & i : ch )
-		dynamic_cast< FormObject* > ( i )->setObjectId( page()->nextId() );
+	o->setPos( pos() );
 
 	return o;
 }
@@ -83,7 +83,7 @@ public:
 	void setRectangle( const QRectF & rect, bool pushUndoCommand = true ) override;
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 protected:
 	//! Handle moved.
@@ -91,6 +91,9 @@ protected:
 	//! Handle released.
 	void handleReleased( FormMoveHandle * handle ) override;
 
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
+
 private:
 	//! Create elem with rect.
 	template< class Elem, class Config >
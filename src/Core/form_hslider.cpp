@@ -77,11 +77,15 @@ FormHSliderPrivate::init()
 		false );
 
 	q->setObjectBrush( Qt::transparent, false );
+
+	updateRenderCache( q, false );
 }
 
 void
 FormHSliderPrivate::setRect( const QRectF & rect )
 {
+	q->prepareGeometryChange();
+
 	m_rect = rect;
 
 	q->setPos( m_rect.topLeft() );
@@ -114,12 +118,11 @@ FormHSlider::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	Q_UNUSED( widget )
 	Q_UNUSED( option )
 
-	draw( painter, d->m_rect, objectPen() );
-
-	if( isSelected() && !group() )
-		d->m_proxy->show();
+	if( isLowDetail( levelOfDetail( painter ),
+		qMin( d->m_rect.width(), d->m_rect.height() ) ) )
+			drawLowDetail( painter, d->m_rect, objectPen(), QBrush( objectPen().color() ) );
 	else
-		d->m_proxy->hide();
+		draw( painter, d->m_rect, objectPen() );
 }
 
 void
@@ -270,6 +273,19 @@ FormHSlider::moveResizable( const QPointF & delta )
 	moveBy( delta.x(), delta.y() );
 }
 
+QVariant
+FormHSlider::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemSelectedHasChanged )
+	{
+		updateRenderCache( this, value.toBool() );
+
+		d->m_proxy->setVisible( value.toBool() && !group() );
+	}
+
+	return QGraphicsItem::itemChange( change, value );
+}
+
 QSizeF
 FormHSlider::defaultSize() const
 {
@@ -277,9 +293,10 @@ FormHSlider::defaultSize() const
 }
 
 FormObject *
-FormHSlider::clone() const
+FormHSlider::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormHSlider( rectangle(), page(), parentItem() );
+	auto * o = new FormHSlider( rectangle(), page(),
+		( parent ? parent : parentItem() ) );
 
 	o->setCfg( cfg() );
 
@@ -89,7 +89,7 @@ public:
 	virtual QSizeF defaultSize() const override;
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 protected:
 	//! Resize.
@@ -97,6 +97,9 @@ protected:
 	//! Move resizable.
 	void moveResizable( const QPointF & delta ) override;
 
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
+
 private:
 	friend class FormHSliderPrivate;
 
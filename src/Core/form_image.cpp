@@ -26,6 +26,7 @@
 #include "page.hpp"
 #include "form_undo_commands.hpp"
 #include "utils.hpp"
+#include "constants.hpp"
 #include "form_object_properties.hpp"
 #include "ui_form_object_properties.h"
 
@@ -37,6 +38,13 @@
 #include <QUndoStack>
 #include <QGraphicsScene>
 #include <QVBoxLayout>
+#include <QPainter>
+#include <QPixmapCache>
+#include <QVector>
+#include <QTimer>
+#include <QImageReader>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
 
 
 namespace Prototyper {
@@ -52,9 +60,16 @@ public:
 	explicit FormImagePrivate( FormImage * parent )
 		:	q( parent )
 		,	m_handles( nullptr )
+		,	m_scaleGeneration( 0 )
+		,	m_smoothGeneration( 0 )
 	{
 	}
 
+	~FormImagePrivate()
+	{
+		clearMips();
+	}
+
 	//! Init.
 	void init();
 	//! Connect properties.
@@ -63,11 +78,46 @@ public:
 	void disconnectProperties();
 	//! \return Full image rect.
 	QRectF imageRect() const;
+	//! \return Level of mip chain that fits the given level of detail.
+	QPixmap mip( qreal lod );
+	//! \return Level of mip chain.
+	QPixmap mipLevel( int level );
+	//! Drop mip chain.
+	void clearMips();
+	//! \return Downscaled copy of the image for interactive scaling.
+	const QImage & preview();
+	//! \return Size of the pixmap for the given rect.
+	QSize targetSize( const QRectF & rect ) const;
+	//! Set image, drop all scaled copies.
+	void setImage( const QImage & img );
+	//! Scale pixmap fast now and schedule smooth scaling.
+	void scale( const QSize & s );
+	//! Start smooth scaling on worker thread.
+	void startSmoothScale();
+	//! Smooth scaling finished.
+	void smoothScaleFinished();
 
 	//! Parent.
 	FormImage * q;
 	//! Image.
 	QImage m_image;
+	//! Base64 PNG data of the image, shared by all configurations.
+	mutable QString m_data;
+	//! Mip chain, level 0 is the pixmap itself. Levels are built on
+	//! demand and live in QPixmapCache so may be evicted.
+	QVector< QPixmapCache::Key > m_mips;
+	//! Downscaled copy of the image, built on demand.
+	QImage m_preview;
+	//! Size of the pixmap.
+	QSize m_targetSize;
+	//! Timer to start smooth scaling when resizing settles.
+	QTimer m_smoothTimer;
+	//! Smooth scaling job.
+	QFutureWatcher< QImage > m_smoothWatcher;
+	//! Generation of the pixmap.
+	quint64 m_scaleGeneration;
+	//! Generation of the smooth scaling job.
+	quint64 m_smoothGeneration;
 	//! Handles.
 	QScopedPointer< FormImageHandles > m_handles;
 	//! Default properties.
@@ -80,6 +130,15 @@ void
 FormImagePrivate::init()
 {
 	m_handles.reset( new FormImageHandles( q, q->parentItem(), q->page() ) );
+
+	m_smoothTimer.setSingleShot( true );
+	m_smoothTimer.setInterval( c_smoothScaleDelay );
+
+	QObject::connect( &m_smoothTimer, &QTimer::timeout, &m_smoothTimer,
+		[this] () { startSmoothScale(); } );
+
+	QObject::connect( &m_smoothWatcher, &QFutureWatcher< QImage >::finished,
+		&m_smoothWatcher, [this] () { smoothScaleFinished(); } );
 }
 
 QRectF
@@ -88,6 +147,141 @@ FormImagePrivate::imageRect() const
 	return QRectF( q->pos(), QSizeF( m_image.size() ) );
 }
 
+QPixmap
+FormImagePrivate::mip( qreal lod )
+{
+	const QPixmap & p = q->pixmap();
+
+	if( p.isNull() || lod >= 1.0 || lod <= 0.0 )
+		return p;
+
+	const qreal deviceSize = qMax( p.width(), p.height() ) * lod;
+
+	int level = 0;
+	int size = qMax( p.width(), p.height() );
+
+	while( size > 1 && size / 2 >= deviceSize )
+	{
+		size /= 2;
+		++level;
+	}
+
+	return mipLevel( level );
+}
+
+QPixmap
+FormImagePrivate::mipLevel( int level )
+{
+	if( level <= 0 )
+		return q->pixmap();
+
+	if( m_mips.size() < level )
+		m_mips.resize( level );
+
+	QPixmap p;
+
+	if( QPixmapCache::find( m_mips.at( level - 1 ), &p ) )
+		return p;
+
+	const QPixmap prev = mipLevel( level - 1 );
+
+	p = prev.scaled( qMax( 1, prev.width() / 2 ), qMax( 1, prev.height() / 2 ),
+		Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
+
+	m_mips[ level - 1 ] = QPixmapCache::insert( p );
+
+	return p;
+}
+
+void
+FormImagePrivate::clearMips()
+{
+	for( const auto & key : qAsConst( m_mips ) )
+		QPixmapCache::remove( key );
+
+	m_mips.clear();
+}
+
+const QImage &
+FormImagePrivate::preview()
+{
+	if( m_preview.isNull() && !m_image.isNull() )
+		m_preview = FormImage::makePreview( m_image );
+
+	return m_preview;
+}
+
+QSize
+FormImagePrivate::targetSize( const QRectF & rect ) const
+{
+	const QSize s( qRound( rect.width() ), qRound( rect.height() ) );
+
+	if( m_handles->isKeepAspectRatio() )
+		return m_image.size().scaled( s, Qt::KeepAspectRatio );
+
+	return s;
+}
+
+void
+FormImagePrivate::setImage( const QImage & img )
+{
+	m_image = img;
+	m_data.clear();
+	m_preview = QImage();
+	clearMips();
+	m_targetSize = m_image.size();
+
+	m_smoothTimer.stop();
+
+	++m_scaleGeneration;
+}
+
+void
+FormImagePrivate::scale( const QSize & s )
+{
+	if( m_image.isNull() || s.isEmpty() )
+		return;
+
+	m_targetSize = s;
+	clearMips();
+
+	++m_scaleGeneration;
+
+	const QImage & source = ( s.width() <= preview().width() &&
+		s.height() <= preview().height() ? preview() : m_image );
+
+	q->setPixmap( QPixmap::fromImage( source.scaled( s, Qt::IgnoreAspectRatio,
+		Qt::FastTransformation ) ) );
+
+	m_smoothTimer.start();
+}
+
+void
+FormImagePrivate::startSmoothScale()
+{
+	const QImage source = m_image;
+	const QSize s = m_targetSize;
+
+	m_smoothGeneration = m_scaleGeneration;
+
+	m_smoothWatcher.setFuture( QtConcurrent::run( [source, s] () {
+		return source.scaled( s, Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
+	} ) );
+}
+
+void
+FormImagePrivate::smoothScaleFinished()
+{
+	if( m_smoothGeneration != m_scaleGeneration )
+		return;
+
+	clearMips();
+
+	q->setPixmap( QPixmap::fromImage( m_smoothWatcher.result() ) );
+
+	q->update();
+}
+
 void
 FormImagePrivate::connectProperties()
 {
@@ -202,11 +396,16 @@ FormImage::cfg() const
 
 	c.set_keepAspectRatio( d->m_handles->isKeepAspectRatio() );
 
-	QByteArray byteArray;
-	QBuffer buffer( &byteArray );
-	d->m_image.save( &buffer, "PNG" );
+	if( d->m_data.isEmpty() && !d->m_image.isNull() )
+	{
+		QByteArray byteArray;
+		QBuffer buffer( &byteArray );
+		d->m_image.save( &buffer, "PNG" );
+
+		d->m_data = QString::fromLatin1( byteArray.toBase64().data() );
+	}
 
-	c.set_data( QString::fromLatin1( byteArray.toBase64().data() ) );
+	c.set_data( d->m_data );
 
 	c.set_z( zValue() );
 
@@ -223,7 +422,9 @@ FormImage::setCfg( const Cfg::Image & c )
 
 	const QByteArray data = QByteArray::fromBase64( c.data().toLatin1() );
 
-	d->m_image = QImage::fromData( data, "PNG" );
+	d->setImage( QImage::fromData( data, "PNG" ) );
+
+	d->m_data = c.data();
 
 	d->m_handles->setKeepAspectRatio( c.keepAspectRatio() );
 
@@ -241,6 +442,10 @@ FormImage::setCfg( const Cfg::Image & c )
 	r.moveLeft( pos().x() );
 
 	d->m_handles->setRect( r );
+
+	// Placeholder has no data, its image may be loaded already.
+	if( c.data().isEmpty() )
+		page()->applyLoadedImage( this );
 }
 
 const QImage &
@@ -252,7 +457,14 @@ FormImage::image() const
 void
 FormImage::setImage( const QImage & img )
 {
-	d->m_image = img;
+	setImage( img, QImage() );
+}
+
+void
+FormImage::setImage( const QImage & img, const QImage & preview )
+{
+	d->setImage( img );
+	d->m_preview = preview;
 
 	setPixmap( QPixmap::fromImage( d->m_image ) );
 
@@ -263,16 +475,88 @@ FormImage::setImage( const QImage & img )
 	d->m_handles->setRect( r );
 }
 
+void
+FormImage::setPlaceholder()
+{
+	QPixmap p( c_imagePlaceholderSize, c_imagePlaceholderSize );
+	p.fill( c_imagePlaceholderColor );
+
+	setPixmap( p );
+
+	QRectF r = pixmap().rect();
+	r.moveTopLeft( pos() );
+
+	d->m_handles->setRect( r );
+}
+
+QImage
+FormImage::readImage( const QString & fileName, int maxSize )
+{
+	QImageReader reader( fileName );
+	reader.setAutoTransform( true );
+
+	const QSize s = reader.size();
+
+	// Let the decoder downscale, it's much cheaper for JPEG.
+	if( maxSize > 0 && s.isValid() &&
+		( s.width() > maxSize || s.height() > maxSize ) )
+			reader.setScaledSize( s.scaled( maxSize, maxSize,
+				Qt::KeepAspectRatio ) );
+
+	return fitImage( reader.read(), maxSize );
+}
+
+QImage
+FormImage::fitImage( const QImage & img, int maxSize )
+{
+	if( maxSize <= 0 || ( img.width() <= maxSize && img.height() <= maxSize ) )
+		return img;
+
+	return img.scaled( maxSize, maxSize, Qt::KeepAspectRatio,
+		Qt::SmoothTransformation );
+}
+
+QImage
+FormImage::makePreview( const QImage & img )
+{
+	if( img.width() > c_imagePreviewSize || img.height() > c_imagePreviewSize )
+		return img.scaled( c_imagePreviewSize, c_imagePreviewSize,
+			Qt::KeepAspectRatio, Qt::SmoothTransformation );
+
+	return img;
+}
+
 void
 FormImage::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	QWidget * widget )
 {
-	QGraphicsPixmapItem::paint( painter, option, widget );
+	const QRectF r = boundingRect();
+	const qreal lod = levelOfDetail( painter );
 
-	if( isSelected() && !group() )
-		d->m_handles->show();
+	if( lod < 1.0 )
+	{
+		const QPixmap p = d->mip( lod );
+
+		if( isLowDetail( lod, qMax( r.width(), r.height() ), c_lodProxySize ) )
+			painter->setRenderHint( QPainter::SmoothPixmapTransform, false );
+		else
+			painter->setRenderHint( QPainter::SmoothPixmapTransform,
+				transformationMode() == Qt::SmoothTransformation );
+
+		painter->drawPixmap( QRectF( offset(), QSizeF( pixmap().size() ) ),
+			p, QRectF( p.rect() ) );
+	}
 	else
-		d->m_handles->hide();
+		QGraphicsPixmapItem::paint( painter, option, widget );
+}
+
+QVariant
+FormImage::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemSelectedHasChanged )
+		d->m_handles->setVisible( value.toBool() && !group() );
+
+	return QGraphicsPixmapItem::itemChange( change, value );
 }
 
 void
@@ -320,10 +604,7 @@ FormImage::resize( const QRectF & rect )
 {
 	setPos( rect.topLeft() );
 
-	setPixmap( QPixmap::fromImage( d->m_image.scaled(
-		QSize( qRound( rect.width() ), qRound( rect.height() ) ),
-		( d->m_handles->isKeepAspectRatio() ? Qt::KeepAspectRatio :
-			Qt::IgnoreAspectRatio ), Qt::SmoothTransformation ) ) );
+	d->scale( d->targetSize( rect ) );
 
 	QRectF r = pixmap().rect();
 	r.moveTop( pos().y() );
@@ -341,34 +622,63 @@ FormImage::moveResizable( const QPointF & delta )
 }
 
 FormObject *
-FormImage::clone() const
+FormImage::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormImage( page(), parentItem() );
-
-	o->setCfg( cfg() );
+	auto * o = new FormImage( page(), ( parent ? parent : parentItem() ) );
 
 	o->setObjectId( page()->nextId() );
 
+	// Image, its PNG data and pixmap are implicitly shared with the copy.
+	o->d->setImage( d->m_image );
+	o->d->m_data = d->m_data;
+	o->d->m_preview = d->m_preview;
+	o->d->m_targetSize = d->m_targetSize;
+	o->d->m_handles->setKeepAspectRatio( d->m_handles->isKeepAspectRatio() );
+
+	o->setPixmap( pixmap() );
+
+	if( d->m_smoothTimer.isActive() || d->m_smoothWatcher.isRunning() )
+		o->d->m_smoothTimer.start();
+
+	o->setPos( pos() );
+
+	o->setZValue( zValue() );
+
+	QRectF r = o->pixmap().rect();
+	r.moveTopLeft( o->pos() );
+
+	o->d->m_handles->setRect( r );
+
 	return o;
 }
 
 QWidget *
-FormImage::properties( QWidget * parent )
+FormImage::properties( QWidget * parent, QWidget * panel )
 {
-	d->m_topProps = new QWidget( parent );
-	QVBoxLayout * layout = new QVBoxLayout( d->m_topProps );
-	layout->setMargin( 0 );
-	layout->setSpacing( 0 );
+	if( panel )
+	{
+		d->m_topProps = panel;
+		d->m_props = panel->findChild< ObjectProperties* > ();
+		d->m_props->setObject( this );
+		d->disconnectProperties();
+	}
+	else
+	{
+		d->m_topProps = new QWidget( parent );
+		QVBoxLayout * layout = new QVBoxLayout( d->m_topProps );
+		layout->setMargin( 0 );
+		layout->setSpacing( 0 );
 
-	d->m_props = new ObjectProperties( this, d->m_topProps );
+		d->m_props = new ObjectProperties( this, d->m_topProps );
 
-	layout->addWidget( d->m_props );
-	layout->addSpacerItem( new QSpacerItem( 0, 0, QSizePolicy::Minimum, QSizePolicy::Expanding ) );
+		layout->addWidget( d->m_props );
+		layout->addSpacerItem( new QSpacerItem( 0, 0, QSizePolicy::Minimum, QSizePolicy::Expanding ) );
+	}
 
-	d->m_props->ui()->m_width->setValue( rectangle().width() );
 	d->m_props->ui()->m_width->setMinimum( minimumSize().width() );
-	d->m_props->ui()->m_height->setValue( rectangle().height() );
+	d->m_props->ui()->m_width->setValue( rectangle().width() );
 	d->m_props->ui()->m_height->setMinimum( minimumSize().height() );
+	d->m_props->ui()->m_height->setValue( rectangle().height() );
 
 	d->m_props->ui()->m_x->setValue( position().x() );
 	d->m_props->ui()->m_y->setValue( position().y() );
@@ -378,6 +688,16 @@ FormImage::properties( QWidget * parent )
 	return d->m_topProps.data();
 }
 
+void
+FormImage::releaseProperties()
+{
+	if( d->m_props )
+		d->disconnectProperties();
+
+	d->m_props = nullptr;
+	d->m_topProps = nullptr;
+}
+
 void
 FormImage::updatePropertiesValues()
 {
@@ -69,6 +69,20 @@ public:
 	const QImage & image() const;
 	//! Set image.
 	void setImage( const QImage & img );
+	//! Set image with its downscaled copy made by makePreview().
+	void setImage( const QImage & img, const QImage & preview );
+	//! Show placeholder while the image is loading.
+	void setPlaceholder();
+
+	//! \return Image read from the file and downscaled to fit \a maxSize,
+	//! 0 means no limit. May be called from any thread.
+	static QImage readImage( const QString & fileName, int maxSize );
+	//! \return Image downscaled to fit \a maxSize, 0 means no limit.
+	//! May be called from any thread.
+	static QImage fitImage( const QImage & img, int maxSize );
+	//! \return Downscaled copy of the image for interactive scaling.
+	//! May be called from any thread.
+	static QImage makePreview( const QImage & img );
 
 	void paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 		QWidget * widget = 0 ) override;
@@ -84,10 +98,11 @@ public:
 	void setRectangle( const QRectF & rect, bool pushUndoCommand = true ) override;
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 	//! \return Widget with properties of object.
-	QWidget * properties( QWidget * parent ) override;
+	QWidget * properties( QWidget * parent, QWidget * panel ) override;
+	void releaseProperties() override;
 
 	//! Update values of properties.
 	void updatePropertiesValues() override;
@@ -98,6 +113,9 @@ protected:
 	//! Move resizable.
 	void moveResizable( const QPointF & delta ) override;
 
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
+
 private:
 	Q_DISABLE_COPY( FormImage )
 
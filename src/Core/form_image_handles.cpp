@@ -26,6 +26,9 @@
 #include "form_resizable_private.hpp"
 #include "constants.hpp"
 
+// Qt include.
+#include <QGraphicsScene>
+
 
 namespace Prototyper {
 
@@ -42,26 +45,64 @@ public:
 	FormImageHandlesPrivate( FormResizable * resizable,
 		FormImageHandles * parent, Page * form )
 		:	FormResizableProxyPrivate( resizable, parent, form )
+		,	m_keepAspectRatio( true )
 	{
 	}
 
 	~FormImageHandlesPrivate() override = default;
 
-	//! Init.
-	void init() Q_DECL_OVERRIDE;
 	//! Place handles.
 	void place( const QRectF & rect ) Q_DECL_OVERRIDE;
+	//! Show handles.
+	void showHandles() Q_DECL_OVERRIDE;
+	//! Hide handles.
+	void hideHandles() Q_DECL_OVERRIDE;
+	//! Place aspect ratio handle.
+	void placeAspectRatioHandle();
 
 	//! Aspect ratio handle.
 	QScopedPointer< AspectRatioHandle > m_aspectRatioHandle;
+	//! Keep aspect ratio while handle is released.
+	bool m_keepAspectRatio;
+	//! Rect of the handles.
+	QRectF m_handlesRect;
 }; // class FormImageHandlesPrivate
 
 void
-FormImageHandlesPrivate::init()
+FormImageHandlesPrivate::showHandles()
+{
+	FormResizableProxyPrivate::showHandles();
+
+	if( !m_aspectRatioHandle )
+	{
+		m_aspectRatioHandle.reset( new AspectRatioHandle( q, m_form ) );
+		m_aspectRatioHandle->setKeepAspectRatio( m_keepAspectRatio );
+
+		placeAspectRatioHandle();
+	}
+}
+
+void
+FormImageHandlesPrivate::hideHandles()
 {
-	FormResizableProxyPrivate::init();
+	FormResizableProxyPrivate::hideHandles();
 
-	m_aspectRatioHandle.reset( new AspectRatioHandle( q ) );
+	if( m_aspectRatioHandle && ( !q->scene() ||
+		q->scene()->mouseGrabberItem() != m_aspectRatioHandle.data() ) )
+	{
+		m_keepAspectRatio = m_aspectRatioHandle->isKeepAspectRatio();
+
+		m_aspectRatioHandle.reset();
+	}
+}
+
+void
+FormImageHandlesPrivate::placeAspectRatioHandle()
+{
+	if( m_aspectRatioHandle )
+		m_aspectRatioHandle->setPos(
+			m_handlesRect.x() - c_halfHandleSize * c_halfDivider * c_halfDivider,
+			m_handlesRect.y() - c_halfHandleSize * c_halfDivider * c_halfDivider );
 }
 
 void
@@ -69,8 +110,9 @@ FormImageHandlesPrivate::place( const QRectF & rect )
 {
 	FormResizableProxyPrivate::place( rect );
 
-	m_aspectRatioHandle->setPos( rect.x() - c_halfHandleSize * c_halfDivider * c_halfDivider,
-		rect.y() - c_halfHandleSize * c_halfDivider * c_halfDivider );
+	m_handlesRect = rect;
+
+	placeAspectRatioHandle();
 
 	q->parentItem()->update(
 		rect.adjusted( -c_halfHandleSize * c_halfDivider * c_halfDivider * c_halfDivider,
@@ -96,13 +138,18 @@ FormImageHandles::~FormImageHandles() = default;
 bool
 FormImageHandles::isKeepAspectRatio() const
 {
-	return d_ptr()->m_aspectRatioHandle->isKeepAspectRatio();
+	return ( d_ptr()->m_aspectRatioHandle ?
+		d_ptr()->m_aspectRatioHandle->isKeepAspectRatio() :
+		d_ptr()->m_keepAspectRatio );
 }
 
 void
 FormImageHandles::setKeepAspectRatio( bool on )
 {
-	d_ptr()->m_aspectRatioHandle->setKeepAspectRatio( on );
+	d_ptr()->m_keepAspectRatio = on;
+
+	if( d_ptr()->m_aspectRatioHandle )
+		d_ptr()->m_aspectRatioHandle->setKeepAspectRatio( on );
 }
 
 QRectF
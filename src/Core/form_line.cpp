@@ -65,6 +65,8 @@ public:
 	void placeChild();
 	//! Create handles.
 	void createHandles();
+	//! Show or hide handles depending on selection.
+	void updateHandles();
 
 	//! Parent.
 	FormLine * q;
@@ -130,6 +132,38 @@ FormLinePrivate::createHandles()
 		q->page(), Qt::SizeAllCursor ) );
 }
 
+void
+FormLinePrivate::updateHandles()
+{
+	if( ( q->isSelected() || m_showHandles ) && !q->group() )
+	{
+		placeChild();
+
+		if( !m_showHandles )
+		{
+			m_h1->setCursor( m_h1->handleCursor() );
+			m_h2->setCursor( m_h2->handleCursor() );
+			m_move->setCursor( m_move->handleCursor() );
+		}
+
+		m_h1->show();
+		m_h2->show();
+		m_move->show();
+	}
+	else
+	{
+		m_h1->hide();
+		m_h1->clear();
+		m_h1->unsetCursor();
+		m_h2->hide();
+		m_h2->clear();
+		m_h2->unsetCursor();
+		m_move->hide();
+		m_move->clear();
+		m_move->unsetCursor();
+	}
+}
+
 
 //
 // FormLine
@@ -189,10 +223,10 @@ FormLine::setCfg( const Cfg::Line & c )
 
 	setLine( line );
 
-	d->placeChild();
-
 	setPos( QPointF( c.pos().x(), c.pos().y() ) );
 
+	d->placeChild();
+
 	setObjectId( c.objectId() );
 
 	setObjectPen( Cfg::fromPen( c.pen() ), false );
@@ -210,47 +244,16 @@ void
 FormLine::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	QWidget * widget )
 {
-	Q_UNUSED( widget )
-
-	if( ( isSelected() || d->m_showHandles ) && !group() )
-	{
-		if( d->m_h1 )
-		{
-			d->placeChild();
-
-			if( !d->m_showHandles )
-				d->m_h1->setCursor( d->m_h1->handleCursor() );
-
-			d->m_h1->show();
-
-			if( !d->m_showHandles )
-				d->m_h2->setCursor( d->m_h2->handleCursor() );
-
-			d->m_h2->show();
-
-			if( !d->m_showHandles )
-				d->m_move->setCursor( d->m_move->handleCursor() );
+	QGraphicsLineItem::paint( painter, option, widget );
+}
 
-			d->m_move->show();
-		}
-	}
-	else
-	{
-		if( d->m_h1 )
-		{
-			d->m_h1->hide();
-			d->m_h1->clear();
-			d->m_h1->unsetCursor();
-			d->m_h2->hide();
-			d->m_h2->clear();
-			d->m_h2->unsetCursor();
-			d->m_move->hide();
-			d->m_move->clear();
-			d->m_h2->unsetCursor();
-		}
-	}
+QVariant
+FormLine::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemSelectedHasChanged )
+		d->updateHandles();
 
-	QGraphicsLineItem::paint( painter, option, widget );
+	return QGraphicsLineItem::itemChange( change, value );
 }
 
 void
@@ -276,6 +279,8 @@ FormLine::showHandles( bool show )
 	d->m_h2->unsetCursor();
 	d->m_move->unsetCursor();
 
+	d->updateHandles();
+
 	update();
 }
 
@@ -385,6 +390,8 @@ FormLine::handleMoved( const QPointF & delta, FormMoveHandle * handle )
 			setLine( QLineF( l.p1(), l.p2() + delta ) );
 		else if( handle == d->m_move.data() )
 			moveBy( delta.x(), delta.y() );
+
+		d->placeChild();
 	}
 }
 
@@ -433,9 +440,9 @@ FormLine::placeHandles()
 }
 
 FormObject *
-FormLine::clone() const
+FormLine::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormLine( page(), parentItem() );
+	auto * o = new FormLine( page(), ( parent ? parent : parentItem() ) );
 
 	o->setCfg( cfg() );
 
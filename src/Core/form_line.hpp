@@ -76,6 +76,8 @@ public:
 
 	//! Show handles.
 	void showHandles( bool show = true );
+	//! Place handles.
+	void placeHandles();
 
 	//! \return Point in the middle of handle if
 	//! given point contained by handle.
@@ -96,7 +98,7 @@ public:
 	void setRectangle( const QRectF & rect, bool pushUndoCommand = true ) override;
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 protected:
 	//! Handle moved.
@@ -109,11 +111,8 @@ protected:
 	void mousePressEvent( QGraphicsSceneMouseEvent * event ) override;
 	void mouseReleaseEvent( QGraphicsSceneMouseEvent * event ) override;
 
-protected:
-	friend class UndoChangeLine;
-
-	//! Place handles.
-	void placeHandles();
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
 
 private:
 	Q_DISABLE_COPY( FormLine )
@@ -34,6 +34,7 @@ namespace Prototyper {
 
 namespace Core {
 
+
 //
 // FormObjectPrivate
 //
@@ -47,6 +48,7 @@ public:
 		,	m_form( form )
 		,	m_type( t )
 		,	m_resizeProps( props )
+		,	m_panels( nullptr )
 	{
 	}
 
@@ -68,6 +70,8 @@ public:
 	QPointer< QWidget > m_topProps;
 	//! Enable resize in properties.
 	int m_resizeProps;
+	//! Panels while the object owns one of them.
+	PropertiesPanels * m_panels;
 }; // class FormObjectPrivate
 
 
@@ -80,20 +84,66 @@ FormObject::FormObject( ObjectType t, Page * parent, int props )
 {
 }
 
-FormObject::~FormObject() = default;
+FormObject::~FormObject()
+{
+	if( !d->m_panels )
+		return;
+
+	const auto it = d->m_panels->m_panels.find( d->m_type );
+
+	// Signals of the widget still lead to this object.
+	if( it != d->m_panels->m_panels.end() && it.value().m_owner == this )
+	{
+		it.value().m_owner = nullptr;
+
+		if( it.value().m_widget )
+			it.value().m_widget->setEnabled( false );
+	}
+}
 
 QWidget *
-FormObject::properties( QWidget * parent )
+FormObject::propertiesPanel( PropertiesPanels & panels, QWidget * parent )
 {
-	d->m_topProps = new QWidget( parent );
-	QVBoxLayout * layout = new QVBoxLayout( d->m_topProps );
-	layout->setMargin( 0 );
-	layout->setSpacing( 0 );
+	auto & panel = panels.m_panels[ d->m_type ];
+
+	if( panel.m_owner && panel.m_owner != this )
+	{
+		panel.m_owner->releaseProperties();
+		panel.m_owner->d->m_panels = nullptr;
+	}
 
-	d->m_props = new ObjectProperties( this, d->m_topProps );
+	panel.m_widget = properties( parent, panel.m_widget.data() );
+	panel.m_owner = ( panel.m_widget ? this : nullptr );
+	d->m_panels = ( panel.m_widget ? &panels : nullptr );
 
-	layout->addWidget( d->m_props );
-	layout->addSpacerItem( new QSpacerItem( 0, 0, QSizePolicy::Minimum, QSizePolicy::Expanding ) );
+	if( panel.m_widget )
+		panel.m_widget->setEnabled( true );
+
+	return panel.m_widget.data();
+}
+
+QWidget *
+FormObject::properties( QWidget * parent, QWidget * panel )
+{
+	if( panel )
+	{
+		d->m_topProps = panel;
+		d->m_props = panel->findChild< ObjectProperties* > ();
+		d->m_props->setObject( this );
+		d->m_props->disconnectProperties();
+	}
+	else
+	{
+		d->m_topProps = new QWidget( parent );
+		QVBoxLayout * layout = new QVBoxLayout( d->m_topProps );
+		layout->setMargin( 0 );
+		layout->setSpacing( 0 );
+
+		d->m_props = new ObjectProperties( this, d->m_topProps );
+
+		layout->addWidget( d->m_props );
+		layout->addSpacerItem( new QSpacerItem( 0, 0, QSizePolicy::Minimum, QSizePolicy::Expanding ) );
+	}
 
 	if( !( d->m_resizeProps & ResizeWidth ) )
 	{
@@ -111,14 +161,16 @@ FormObject::properties( QWidget * parent )
 
 	if( d->m_resizeProps & ResizeWidth )
 	{
-		d->m_props->ui()->m_width->setValue( rectangle().width() );
+		d->m_props->ui()->m_width->setEnabled( true );
 		d->m_props->ui()->m_width->setMinimum( minimumSize().width() );
+		d->m_props->ui()->m_width->setValue( rectangle().width() );
 	}
 
 	if( d->m_resizeProps & ResizeHeight )
 	{
-		d->m_props->ui()->m_height->setValue( rectangle().height() );
+		d->m_props->ui()->m_height->setEnabled( true );
 		d->m_props->ui()->m_height->setMinimum( minimumSize().height() );
+		d->m_props->ui()->m_height->setValue( rectangle().height() );
 	}
 
 	d->m_props->ui()->m_x->setValue( position().x() );
@@ -129,6 +181,16 @@ FormObject::properties( QWidget * parent )
 	return d->m_topProps.data();
 }
 
+void
+FormObject::releaseProperties()
+{
+	if( d->m_props )
+		d->m_props->disconnectProperties();
+
+	d->m_props = nullptr;
+	d->m_topProps = nullptr;
+}
+
 void
 FormObject::updatePropertiesValues()
 {
@@ -258,6 +320,21 @@ FormObject::setRectangle( const QRectF & rect,
 	}
 }
 
+
+//
+// PropertiesPanels
+//
+
+PropertiesPanels::~PropertiesPanels()
+{
+	// Objects may outlive the panels.
+	for( const auto & panel : qAsConst( m_panels ) )
+	{
+		if( panel.m_owner )
+			panel.m_owner->d->m_panels = nullptr;
+	}
+}
+
 } /* namespace Core */
 
 } /* namespace Prototyper */
@@ -27,6 +27,13 @@
 #include <QtGlobal>
 #include <QPen>
 #include <QBrush>
+#include <QHash>
+#include <QPointer>
+
+QT_BEGIN_NAMESPACE
+class QGraphicsItem;
+class QWidget;
+QT_END_NAMESPACE
 
 
 namespace Prototyper {
@@ -35,6 +42,7 @@ namespace Core {
 
 class Page;
 class ObjectProperties;
+class PropertiesPanels;
 
 
 //
@@ -128,21 +136,59 @@ public:
 	//! Post deletion.
 	virtual void postDeletion();
 
-	//! \return Widget with properties of object.
-	virtual QWidget * properties( QWidget * parent );
+	//! \return Widget with properties of object. Objects of the same type
+	//! share one widget of \a panels, it's rebound to this object.
+	QWidget * propertiesPanel( PropertiesPanels & panels, QWidget * parent );
+
+	//! \return Widget with properties of object. If \a panel is given it
+	//! was made by the object of the same type and is rebound to this one.
+	virtual QWidget * properties( QWidget * parent, QWidget * panel );
+	//! Widget with properties was given to another object.
+	virtual void releaseProperties();
 
 	//! Update values of properties.
 	virtual void updatePropertiesValues();
 
-	//! Clone object.
-	virtual FormObject * clone() const = 0;
+	//! Clone object. The clone is placed into \a parent, or next to the
+	//! object if \a parent is null.
+	virtual FormObject * clone( QGraphicsItem * parent = nullptr ) const = 0;
 
 private:
+	friend class PropertiesPanels;
+
 	Q_DISABLE_COPY( FormObject )
 
 	QScopedPointer< FormObjectPrivate > d;
 }; // class FormObject
 
+
+//
+// PropertiesPanels
+//
+
+//! Widgets with properties shared by objects of the same type.
+class PropertiesPanels final {
+public:
+	PropertiesPanels() = default;
+	~PropertiesPanels();
+
+private:
+	friend class FormObject;
+
+	Q_DISABLE_COPY( PropertiesPanels )
+
+	//! Widget with properties of one type of object.
+	struct Panel {
+		//! Widget.
+		QPointer< QWidget > m_widget;
+		//! Object the widget is bound to.
+		FormObject * m_owner = nullptr;
+	}; // struct Panel
+
+	//! Panels by type of object.
+	QHash< int, Panel > m_panels;
+}; // class PropertiesPanels
+
 } /* namespace Core */
 
 } /* namespace Prototyper */
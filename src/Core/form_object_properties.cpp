@@ -87,6 +87,12 @@ ObjectProperties::ui() const
 	return &d->m_ui;
 }
 
+void
+ObjectProperties::setObject( FormObject * obj )
+{
+	d->m_obj = obj;
+}
+
 void
 ObjectProperties::connectProperties()
 {
@@ -59,6 +59,9 @@ public:
 
 	Ui::ObjectProperties * ui() const;
 
+	//! Set object.
+	void setObject( FormObject * obj );
+
 	//! Connect properties signals/slots.
 	void connectProperties();
 	//! Disconnect properties signals/slots.
@@ -0,0 +1,341 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2016-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Prototyper include.
+#include "form_object_snap.hpp"
+#include "form_object.hpp"
+#include "constants.hpp"
+
+// Qt include.
+#include <QGraphicsItem>
+#include <QHash>
+#include <QSet>
+#include <QRectF>
+
+// C++ include.
+#include <algorithm>
+#include <vector>
+
+
+namespace Prototyper {
+
+namespace Core {
+
+//
+// ObjectSnapPrivate
+//
+
+class ObjectSnapPrivate {
+public:
+	explicit ObjectSnapPrivate( QGraphicsItem * page )
+		:	m_page( page )
+		,	m_isChanged( true )
+	{
+	}
+
+	//! Edge or center of the object.
+	struct Anchor {
+		//! Coordinate.
+		qreal m_value;
+		//! Object.
+		QGraphicsItem * m_item;
+
+		bool operator < ( const Anchor & other ) const
+		{
+			return m_value < other.m_value;
+		}
+	}; // struct Anchor
+
+	//! Anchors.
+	using Anchors = std::vector< Anchor >;
+
+	//! Update index.
+	void refresh();
+	//! Rebuild index.
+	void rebuild();
+	//! Insert anchors of the object.
+	void insert( QGraphicsItem * item, const QRectF & r );
+	//! Remove anchors of the object.
+	void remove( QGraphicsItem * item, const QRectF & r );
+	//! Insert anchor.
+	static void insert( Anchors & anchors, qreal value, QGraphicsItem * item );
+	//! Remove anchor.
+	static void remove( Anchors & anchors, qreal value, QGraphicsItem * item );
+	//! \return Nearest anchor within the tolerance.
+	static const Anchor * nearest( const Anchors & anchors, qreal value,
+		qreal tolerance );
+
+	//! Page.
+	QGraphicsItem * m_page;
+	//! Vertical edges and centers.
+	Anchors m_x;
+	//! Horizontal edges and centers.
+	Anchors m_y;
+	//! Indexed rectangles of objects.
+	QHash< QGraphicsItem*, QRectF > m_rects;
+	//! Objects were changed?
+	bool m_isChanged;
+}; // class ObjectSnapPrivate
+
+void
+ObjectSnapPrivate::refresh()
+{
+	m_isChanged = false;
+
+	const QList< QGraphicsItem* > children = m_page->childItems();
+
+	QVector< QPair< QGraphicsItem*, QRectF > > changed;
+	QSet< QGraphicsItem* > alive;
+	alive.reserve( children.size() );
+
+	for( const auto & child : children )
+	{
+		const auto * obj = dynamic_cast< FormObject* > ( child );
+
+		if( !obj )
+			continue;
+
+		alive.insert( child );
+
+		const QRectF r = obj->rectangle();
+
+		const auto it = m_rects.constFind( child );
+
+		if( it == m_rects.constEnd() || it.value() != r )
+			changed.append( qMakePair( child, r ) );
+	}
+
+	// Many objects changed, it's faster to sort everything again.
+	if( changed.size() * c_objectSnapRebuildRatio > alive.size() )
+	{
+		rebuild();
+
+		return;
+	}
+
+	for( auto it = m_rects.begin(); it != m_rects.end(); )
+	{
+		if( !alive.contains( it.key() ) )
+		{
+			remove( it.key(), it.value() );
+
+			it = m_rects.erase( it );
+		}
+		else
+			++it;
+	}
+
+	for( const auto & c : qAsConst( changed ) )
+	{
+		const auto it = m_rects.find( c.first );
+
+		if( it != m_rects.end() )
+		{
+			remove( c.first, it.value() );
+
+			it.value() = c.second;
+		}
+		else
+			m_rects.insert( c.first, c.second );
+
+		insert( c.first, c.second );
+	}
+}
+
+void
+ObjectSnapPrivate::rebuild()
+{
+	m_x.clear();
+	m_y.clear();
+	m_rects.clear();
+
+	for( const auto & child : m_page->childItems() )
+	{
+		const auto * obj = dynamic_cast< FormObject* > ( child );
+
+		if( obj )
+		{
+			const QRectF r = obj->rectangle();
+
+			m_rects.insert( child, r );
+
+			m_x.push_back( { r.left(), child } );
+			m_x.push_back( { r.center().x(), child } );
+			m_x.push_back( { r.right(), child } );
+
+			m_y.push_back( { r.top(), child } );
+			m_y.push_back( { r.center().y(), child } );
+			m_y.push_back( { r.bottom(), child } );
+		}
+	}
+
+	std::sort( m_x.begin(), m_x.end() );
+	std::sort( m_y.begin(), m_y.end() );
+}
+
+void
+ObjectSnapPrivate::insert( QGraphicsItem * item, const QRectF & r )
+{
+	insert( m_x, r.left(), item );
+	insert( m_x, r.center().x(), item );
+	insert( m_x, r.right(), item );
+
+	insert( m_y, r.top(), item );
+	insert( m_y, r.center().y(), item );
+	insert( m_y, r.bottom(), item );
+}
+
+void
+ObjectSnapPrivate::remove( QGraphicsItem * item, const QRectF & r )
+{
+	remove( m_x, r.left(), item );
+	remove( m_x, r.center().x(), item );
+	remove( m_x, r.right(), item );
+
+	remove( m_y, r.top(), item );
+	remove( m_y, r.center().y(), item );
+	remove( m_y, r.bottom(), item );
+}
+
+void
+ObjectSnapPrivate::insert( Anchors & anchors, qreal value, QGraphicsItem * item )
+{
+	const Anchor a = { value, item };
+
+	anchors.insert( std::upper_bound( anchors.begin(), anchors.end(), a ), a );
+}
+
+void
+ObjectSnapPrivate::remove( Anchors & anchors, qreal value, QGraphicsItem * item )
+{
+	const Anchor a = { value, item };
+
+	const auto range = std::equal_range( anchors.begin(), anchors.end(), a );
+
+	const auto it = std::find_if( range.first, range.second,
+		[item] ( const Anchor & other ) { return other.m_item == item; } );
+
+	if( it != range.second )
+		anchors.erase( it );
+}
+
+const ObjectSnapPrivate::Anchor *
+ObjectSnapPrivate::nearest( const Anchors & anchors, qreal value,
+	qreal tolerance )
+{
+	const Anchor from = { value - tolerance, nullptr };
+
+	const Anchor * res = nullptr;
+	qreal distance = tolerance;
+
+	for( auto it = std::lower_bound( anchors.cbegin(), anchors.cend(), from );
+		it != anchors.cend() && it->m_value <= value + tolerance; ++it )
+	{
+		const qreal dist = qAbs( it->m_value - value );
+
+		if( dist <= distance && !it->m_item->isSelected() )
+		{
+			distance = dist;
+			res = &( *it );
+		}
+	}
+
+	return res;
+}
+
+
+//
+// ObjectSnap
+//
+
+ObjectSnap::ObjectSnap( QGraphicsItem * page )
+	:	d( new ObjectSnapPrivate( page ) )
+{
+}
+
+ObjectSnap::~ObjectSnap() = default;
+
+void
+ObjectSnap::invalidate()
+{
+	d->m_isChanged = true;
+}
+
+void
+ObjectSnap::removeItem( QGraphicsItem * item )
+{
+	const auto it = d->m_rects.find( item );
+
+	if( it != d->m_rects.end() )
+	{
+		d->remove( item, it.value() );
+
+		d->m_rects.erase( it );
+	}
+}
+
+void
+ObjectSnap::clear()
+{
+	d->m_x.clear();
+	d->m_y.clear();
+	d->m_rects.clear();
+	d->m_isChanged = true;
+}
+
+QPointF
+ObjectSnap::snapped( const QPointF & p, const QPointF & gridPos,
+	qreal tolerance, QVector< QLineF > & guides )
+{
+	guides.clear();
+
+	if( d->m_isChanged )
+		d->refresh();
+
+	const auto * x = ObjectSnapPrivate::nearest( d->m_x, p.x(), tolerance );
+	const auto * y = ObjectSnapPrivate::nearest( d->m_y, p.y(), tolerance );
+
+	const QPointF res( x ? x->m_value : gridPos.x(),
+		y ? y->m_value : gridPos.y() );
+
+	if( x )
+	{
+		const QRectF r = d->m_rects.value( x->m_item );
+
+		guides.append( QLineF( res.x(), qMin( res.y(), r.top() ),
+			res.x(), qMax( res.y(), r.bottom() ) ) );
+	}
+
+	if( y )
+	{
+		const QRectF r = d->m_rects.value( y->m_item );
+
+		guides.append( QLineF( qMin( res.x(), r.left() ), res.y(),
+			qMax( res.x(), r.right() ), res.y() ) );
+	}
+
+	return res;
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
@@ -0,0 +1,79 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2016-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROTOTYPER__CORE__FORM_OBJECT_SNAP_HPP__INCLUDED
+#define PROTOTYPER__CORE__FORM_OBJECT_SNAP_HPP__INCLUDED
+
+// Qt include.
+#include <QScopedPointer>
+#include <QPointF>
+#include <QLineF>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QGraphicsItem;
+QT_END_NAMESPACE
+
+
+namespace Prototyper {
+
+namespace Core {
+
+//
+// ObjectSnap
+//
+
+class ObjectSnapPrivate;
+
+//! Snap to edges and centers of objects on the page.
+//! Edges and centers are kept sorted by coordinate, so the nearest one
+//! is found with binary search. Index is updated lazily on the next
+//! query after objects were changed, only changed objects are reindexed.
+class ObjectSnap final {
+public:
+	explicit ObjectSnap( QGraphicsItem * page );
+	~ObjectSnap();
+
+	//! Objects on the page were changed.
+	void invalidate();
+	//! Item was removed from the page.
+	void removeItem( QGraphicsItem * item );
+	//! All objects were removed from the page.
+	void clear();
+
+	//! \return Point snapped to the nearest edges or centers of objects
+	//! within the tolerance, coordinates without such objects are taken
+	//! from \a gridPos. Selected objects are ignored.
+	QPointF snapped( const QPointF & p, const QPointF & gridPos,
+		qreal tolerance, QVector< QLineF > & guides );
+
+private:
+	Q_DISABLE_COPY( ObjectSnap )
+
+	QScopedPointer< ObjectSnapPrivate > d;
+}; // class ObjectSnap
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__FORM_OBJECT_SNAP_HPP__INCLUDED
@@ -33,17 +33,160 @@
 
 // Qt include.
 #include <QStyleOptionGraphicsItem>
-#include <QPolygonF>
 #include <QApplication>
 #include <QPainter>
 #include <QUndoStack>
 #include <QGraphicsScene>
+#include <QHash>
+#include <QVector>
+#include <QtMath>
 
 
 namespace Prototyper {
 
 namespace Core {
 
+//
+// PolylineSegmentIndex
+//
+
+//! Grid of segments of the polyline's path for hit-testing.
+class PolylineSegmentIndex final {
+public:
+	PolylineSegmentIndex()
+		:	m_isValid( false )
+	{
+	}
+
+	//! \return Is index built?
+	bool isValid() const
+	{
+		return m_isValid;
+	}
+
+	//! Clear index.
+	void clear()
+	{
+		m_segments.clear();
+		m_cells.clear();
+		m_isValid = false;
+	}
+
+	//! Build index of the path.
+	void build( const QPainterPath & path );
+	//! Append segment.
+	void append( const QLineF & segment );
+	//! \return Is point closer to one of the segments than tolerance?
+	bool contains( const QPointF & p, qreal tolerance ) const;
+
+private:
+	//! \return Cell of the point.
+	static QPoint cell( const QPointF & p )
+	{
+		return QPoint( qFloor( p.x() / c_polylineIndexCellSize ),
+			qFloor( p.y() / c_polylineIndexCellSize ) );
+	}
+
+	//! \return Key of the cell.
+	static quint64 key( int x, int y )
+	{
+		return ( static_cast< quint64 > ( static_cast< quint32 > ( x ) ) << 32 ) |
+			static_cast< quint32 > ( y );
+	}
+
+private:
+	//! Segments.
+	QVector< QLineF > m_segments;
+	//! Segments in cells.
+	QHash< quint64, QVector< int > > m_cells;
+	//! Is index built?
+	bool m_isValid;
+}; // class PolylineSegmentIndex
+
+void
+PolylineSegmentIndex::build( const QPainterPath & path )
+{
+	clear();
+
+	m_segments.reserve( path.elementCount() );
+
+	m_isValid = true;
+
+	for( int i = 1; i < path.elementCount(); ++i )
+	{
+		const QPainterPath::Element e = path.elementAt( i );
+
+		if( e.isLineTo() )
+		{
+			const QPainterPath::Element prev = path.elementAt( i - 1 );
+
+			append( QLineF( prev.x, prev.y, e.x, e.y ) );
+		}
+	}
+}
+
+void
+PolylineSegmentIndex::append( const QLineF & segment )
+{
+	const int idx = m_segments.size();
+
+	m_segments.append( segment );
+
+	const QPoint c1 = cell( segment.p1() );
+	const QPoint c2 = cell( segment.p2() );
+
+	for( int x = qMin( c1.x(), c2.x() ), lastX = qMax( c1.x(), c2.x() );
+		x <= lastX; ++x )
+	{
+		for( int y = qMin( c1.y(), c2.y() ), lastY = qMax( c1.y(), c2.y() );
+			y <= lastY; ++y )
+				m_cells[ key( x, y ) ].append( idx );
+	}
+}
+
+//! \return Distance from point to segment.
+static inline qreal distanceToSegment( const QPointF & p, const QLineF & l )
+{
+	const QPointF d = l.p2() - l.p1();
+
+	const qreal len2 = QPointF::dotProduct( d, d );
+
+	if( qFuzzyIsNull( len2 ) )
+		return QLineF( p, l.p1() ).length();
+
+	const qreal t = qBound( 0.0, QPointF::dotProduct( p - l.p1(), d ) / len2,
+		1.0 );
+
+	return QLineF( p, l.p1() + d * t ).length();
+}
+
+bool
+PolylineSegmentIndex::contains( const QPointF & p, qreal tolerance ) const
+{
+	const QPoint c1 = cell( p - QPointF( tolerance, tolerance ) );
+	const QPoint c2 = cell( p + QPointF( tolerance, tolerance ) );
+
+	for( int x = c1.x(); x <= c2.x(); ++x )
+	{
+		for( int y = c1.y(); y <= c2.y(); ++y )
+		{
+			const auto it = m_cells.constFind( key( x, y ) );
+
+			if( it != m_cells.constEnd() )
+			{
+				for( const auto & idx : it.value() )
+				{
+					if( distanceToSegment( p, m_segments.at( idx ) ) <= tolerance )
+						return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+
 //
 // FormPolylinePrivate
 //
@@ -57,6 +200,8 @@ public:
 		,	m_closed( false )
 		,	m_handles( nullptr )
 		,	m_handleMoved( false )
+		,	m_isRawPath( false )
+		,	m_isShapeValid( false )
 	{
 	}
 
@@ -64,6 +209,20 @@ public:
 	void init();
 	//! Make path.
 	void makePath();
+	//! Append line to the end of the path.
+	void appendToPath( const QLineF & line );
+	//! Set path of the item with its bounds.
+	void setPath( const QPainterPath & path, const QRectF & bounds );
+	//! Update state after the change of lines.
+	void linesChanged();
+	//! Add line to the lines, \return true if it was appended to the end.
+	bool addLine( const QLineF & line );
+	//! Place start and end handles.
+	void placeEnds();
+	//! Place resize & move handles around the resized rect.
+	void placeHandles();
+	//! \return Vertices of the polyline in the cfg, in mm.
+	static QVector< QPointF > vertices( const Cfg::Polyline & c );
 	//! Update lines.
 	void updateLines( const QRectF & oldR, const QRectF & newR );
 	//! \return Bounding rect.
@@ -71,10 +230,12 @@ public:
 
 	//! Parent.
 	FormPolyline * q;
-	//! Lines.
-	QList< QLineF > m_lines;
-	//! Polygon.
-	QPolygonF m_polygon;
+	//! Vertices of the polyline, first vertex is repeated at the end if closed.
+	QVector< QPointF > m_points;
+	//! Bounding rect of the lines.
+	QRectF m_bounds;
+	//! Bounding rect of the item's path.
+	QRectF m_pathBounds;
 	//! Start handle.
 	QScopedPointer< FormMoveHandle > m_start;
 	//! End handle.
@@ -89,6 +250,14 @@ public:
 	QRectF m_subsidiaryRect;
 	//! Handle moved?
 	bool m_handleMoved;
+	//! Is path of the item made from lines as is, i.e. not resized?
+	bool m_isRawPath;
+	//! Cached shape.
+	mutable QPainterPath m_shape;
+	//! Is cached shape valid?
+	mutable bool m_isShapeValid;
+	//! Index of the path's segments.
+	mutable PolylineSegmentIndex m_index;
 }; // class FormPolylinePrivate
 
 void
@@ -130,42 +299,102 @@ void
 FormPolylinePrivate::makePath()
 {
 	QPainterPath path;
-	QPointF first;
 
-	QVector< QPointF > points;
-	points.reserve( m_lines.size() * 2 );
+	m_closed = false;
+	m_bounds = QRectF();
 
-	for( int i = 0; i < m_lines.size(); ++i )
+	if( !m_points.isEmpty() )
 	{
-		const QLineF line = m_lines.at( i );
+		const QPointF first = m_points.first();
 
-		points.append( line.p1() );
-		points.append( line.p2() );
+		qreal left = first.x(), right = first.x();
+		qreal top = first.y(), bottom = first.y();
 
-		if( i == 0 )
+		path.moveTo( first );
+
+		for( int i = 1; i < m_points.size(); ++i )
 		{
-			path.moveTo( line.p1() );
+			const QPointF & pt = m_points.at( i );
+
+			path.lineTo( pt );
 
-			first = line.p1();
+			left = qMin( left, pt.x() );
+			right = qMax( right, pt.x() );
+			top = qMin( top, pt.y() );
+			bottom = qMax( bottom, pt.y() );
 		}
 
-		path.lineTo( line.p2() );
+		m_bounds = QRectF( QPointF( left, top ), QPointF( right, bottom ) );
 
-		if( i + 1 == m_lines.size() && line.p2() == first )
-			m_closed = true;
-		else
-			m_closed = false;
+		m_closed = ( m_points.size() > 2 && m_points.last() == first );
+	}
+
+	setPath( path, m_bounds );
+
+	m_isRawPath = true;
+
+	linesChanged();
+}
+
+void
+FormPolylinePrivate::appendToPath( const QLineF & line )
+{
+	if( !m_isRawPath || m_points.size() < 3 )
+	{
+		makePath();
+
+		return;
 	}
 
-	m_polygon = QPolygonF( points );
+	// Item shares the path with us, release it to not copy it on append.
+	// Bounds are ours, so neither call strokes or scans the path.
+	QPainterPath path = q->path();
+	q->setPath( QPainterPath() );
+
+	path.lineTo( line.p2() );
+
+	const QRectF r = QRectF( line.p1(), line.p2() ).normalized();
+
+	m_bounds = QRectF(
+		QPointF( qMin( m_bounds.left(), r.left() ),
+			qMin( m_bounds.top(), r.top() ) ),
+		QPointF( qMax( m_bounds.right(), r.right() ),
+			qMax( m_bounds.bottom(), r.bottom() ) ) );
+
+	m_closed = ( line.p2() == m_points.first() );
 
 	q->setPath( path );
 
+	m_pathBounds = m_bounds;
+	m_isShapeValid = false;
+
+	if( m_index.isValid() )
+		m_index.append( line );
+
+	linesChanged();
+}
+
+void
+FormPolylinePrivate::setPath( const QPainterPath & path, const QRectF & bounds )
+{
+	q->setPath( path );
+
+	m_pathBounds = bounds;
+
+	m_isShapeValid = false;
+	m_index.clear();
+}
+
+void
+FormPolylinePrivate::linesChanged()
+{
 	QRectF r = boundingRect();
 	r.moveTopLeft( r.topLeft() + q->pos() );
 
 	m_resized = r;
 
+	placeHandles();
+
 	if( m_closed )
 	{
 		q->setBrush( q->objectBrush() );
@@ -174,21 +403,99 @@ FormPolylinePrivate::makePath()
 	}
 }
 
+bool
+FormPolylinePrivate::addLine( const QLineF & line )
+{
+	if( m_points.isEmpty() )
+	{
+		m_points.append( line.p1() );
+		m_points.append( line.p2() );
+
+		return true;
+	}
+	else if( m_points.last() == line.p1() )
+	{
+		m_points.append( line.p2() );
+
+		return true;
+	}
+	else
+	{
+		if( m_points.first() != line.p1() )
+			m_points.prepend( line.p1() );
+
+		m_points.prepend( line.p2() );
+
+		return false;
+	}
+}
+
 void
-FormPolylinePrivate::updateLines( const QRectF & oldR, const QRectF & newR )
+FormPolylinePrivate::placeEnds()
 {
-	Q_UNUSED( oldR )
+	if( m_points.isEmpty() )
+		return;
 
-	const QRectF b = boundingRect();
+	m_start->setPos( m_points.first() -
+		QPointF( m_start->halfOfSize(), m_start->halfOfSize() ) + q->pos() );
 
-	m_resized = newR;
+	m_end->setPos( m_points.last() -
+		QPointF( m_end->halfOfSize(), m_end->halfOfSize() ) + q->pos() );
+}
+
+QVector< QPointF >
+FormPolylinePrivate::vertices( const Cfg::Polyline & c )
+{
+	QVector< QPointF > points;
+
+	if( !c.coordinates().empty() )
+	{
+		const auto & coords = c.coordinates();
 
+		points.reserve( static_cast< int > ( coords.size() / 2 ) + 1 );
+
+		for( std::size_t i = 0; i + 1 < coords.size(); i += 2 )
+			points.append( QPointF( coords.at( i ), coords.at( i + 1 ) ) );
+
+		if( c.closed() && points.size() > 2 )
+			points.append( points.first() );
+	}
+	// Projects saved before compact format.
+	else if( !c.line().empty() )
+	{
+		points.reserve( static_cast< int > ( c.line().size() ) + 1 );
+
+		points.append( QPointF( c.line().front().p1().x(),
+			c.line().front().p1().y() ) );
+
+		for( const auto & l : c.line() )
+			points.append( QPointF( l.p2().x(), l.p2().y() ) );
+	}
+
+	return points;
+}
+
+void
+FormPolylinePrivate::placeHandles()
+{
 	const qreal w = (qreal) q->objectPen().width() / c_halfDivider;
 
 	m_handles->place( m_resized.adjusted( -c_halfHandleSize * c_halfDivider * c_halfDivider - w,
 		-c_halfHandleSize * c_halfDivider * c_halfDivider - w,
 		c_halfHandleSize * c_halfDivider * c_halfDivider + w,
 		c_halfHandleSize * c_halfDivider * c_halfDivider + w ) );
+}
+
+void
+FormPolylinePrivate::updateLines( const QRectF & oldR, const QRectF & newR )
+{
+	Q_UNUSED( oldR )
+
+	const QRectF b = boundingRect();
+
+	m_resized = newR;
+
+	placeHandles();
 
 	const qreal mx = b.width() / m_resized.width();
 	const qreal my = b.height() / m_resized.height();
@@ -197,23 +504,21 @@ FormPolylinePrivate::updateLines( const QRectF & oldR, const QRectF & newR )
 
 	QPainterPath path;
 
-	for( int i = 0; i < m_lines.size(); ++i )
+	for( int i = 0; i < m_points.size(); ++i )
 	{
-		const QLineF line = m_lines.at( i );
+		const QPointF pt(
+			( m_points.at( i ).x() - b.x() ) / mx + m_resized.x() - p.x(),
+			( m_points.at( i ).y() - b.y() ) / my + m_resized.y() - p.y() );
 
 		if( i == 0 )
-		{
-			path.moveTo( QPointF(
-				( line.p1().x() - b.x() ) / mx + m_resized.x() - p.x(),
-				( line.p1().y() - b.y() ) / my + m_resized.y() - p.y() ) );
-		}
-
-		path.lineTo( QPointF(
-			( line.p2().x() - b.x() ) / mx + m_resized.x() - p.x(),
-			( line.p2().y() - b.y() ) / my + m_resized.y() - p.y() ) );
+			path.moveTo( pt );
+		else
+			path.lineTo( pt );
 	}
 
-	q->setPath( path );
+	setPath( path, m_resized.translated( -p ) );
+
+	m_isRawPath = false;
 
 	//q->setPos( 0.0, 0.0 );
 }
@@ -221,7 +526,7 @@ FormPolylinePrivate::updateLines( const QRectF & oldR, const QRectF & newR )
 QRectF
 FormPolylinePrivate::boundingRect() const
 {
-	return m_polygon.boundingRect();
+	return m_bounds;
 }
 
 
@@ -252,25 +557,22 @@ FormPolyline::cfg() const
 
 	c.set_pos( p );
 
-	foreach( const QLineF & l, d->m_lines )
-	{
-		Cfg::Point p1;
-		p1.set_x( MmPx::instance().toMmX( l.p1().x() ) );
-		p1.set_y( MmPx::instance().toMmY( l.p1().y() ) );
-
-		Cfg::Point p2;
-		p2.set_x( MmPx::instance().toMmX( l.p2().x() ) );
-		p2.set_y( MmPx::instance().toMmY( l.p2().y() ) );
-
-		Cfg::Line line;
-		line.set_p1( p1 );
-		line.set_p2( p2 );
+	// Closing vertex isn't stored, closed flag is stored instead.
+	const int count = ( d->m_closed ? d->m_points.size() - 1 :
+		d->m_points.size() );
 
-		line.set_pen( Cfg::pen( objectPen() ) );
+	c.coordinates().reserve( static_cast< std::size_t > ( count ) * 2 );
 
-		c.line().push_back( line );
+	for( int i = 0; i < count; ++i )
+	{
+		c.coordinates().push_back(
+			MmPx::instance().toMmX( d->m_points.at( i ).x() ) );
+		c.coordinates().push_back(
+			MmPx::instance().toMmY( d->m_points.at( i ).y() ) );
 	}
 
+	c.set_closed( d->m_closed );
+
 	c.set_pen( Cfg::pen( objectPen() ) );
 
 	c.set_brush( Cfg::brush( objectBrush() ) );
@@ -291,21 +593,18 @@ FormPolyline::setCfg( const Cfg::Polyline & c )
 {
 	setObjectId( c.objectId() );
 
-	d->m_lines.clear();
-
 	setPos( QPointF( MmPx::instance().fromMmX( c.pos().x() ),
 		MmPx::instance().fromMmY( c.pos().y() ) ) );
 
-	foreach( const Cfg::Line & l, c.line() )
-	{
-		QLineF line;
-		line.setP1( QPointF( MmPx::instance().fromMmX( l.p1().x() ),
-			MmPx::instance().fromMmY( l.p1().y() ) ) );
-		line.setP2( QPointF( MmPx::instance().fromMmX( l.p2().x() ),
-			MmPx::instance().fromMmY( l.p2().y() ) ) );
+	d->m_points = FormPolylinePrivate::vertices( c );
 
-		appendLine( line );
-	}
+	for( auto & pt : d->m_points )
+		pt = QPointF( MmPx::instance().fromMmX( pt.x() ),
+			MmPx::instance().fromMmY( pt.y() ) );
+
+	d->makePath();
+
+	d->placeEnds();
 
 	setObjectPen( Cfg::fromPen( c.pen() ), false );
 
@@ -320,45 +619,38 @@ FormPolyline::setCfg( const Cfg::Polyline & c )
 		MmPx::instance().fromMmX( c.size().width() ),
 		MmPx::instance().fromMmY( c.size().height() ) );
 
-	const qreal w = (qreal) objectPen().width() / c_halfDivider;
-
-	d->m_handles->place( d->m_resized.adjusted(
-		-c_halfHandleSize * c_halfDivider * c_halfDivider - w,
-		-c_halfHandleSize * c_halfDivider * c_halfDivider - w,
-		c_halfHandleSize * c_halfDivider * c_halfDivider + w,
-		c_halfHandleSize * c_halfDivider * c_halfDivider + w ) );
-
 	d->updateLines( QRectF(), d->m_resized );
 }
 
 void
 FormPolyline::draw( QPainter * painter, const Cfg::Polyline & cfg, qreal dpi )
 {
-	QList< QLineF > lines;
+	QVector< QPointF > points = FormPolylinePrivate::vertices( cfg );
 
-	foreach( const Cfg::Line & l, cfg.line() )
+	qreal left = 0.0, right = 0.0, top = 0.0, bottom = 0.0;
+
+	for( int i = 0; i < points.size(); ++i )
 	{
-		QLineF line;
-		line.setP1( QPointF( MmPx::instance().fromMm( l.p1().x(), dpi ),
-			MmPx::instance().fromMm( l.p1().y(), dpi ) ) );
-		line.setP2( QPointF( MmPx::instance().fromMm( l.p2().x(), dpi ),
-			MmPx::instance().fromMm( l.p2().y(), dpi ) ) );
+		const QPointF pt( MmPx::instance().fromMm( points.at( i ).x(), dpi ),
+			MmPx::instance().fromMm( points.at( i ).y(), dpi ) );
 
-		lines.append( line );
-	}
+		points[ i ] = pt;
 
-	QVector< QPointF > points;
-	points.reserve( lines.size() * 2 );
-
-	for( const auto & line : qAsConst( lines ) )
-	{
-		points.append( line.p1() );
-		points.append( line.p2() );
+		if( i == 0 )
+		{
+			left = right = pt.x();
+			top = bottom = pt.y();
+		}
+		else
+		{
+			left = qMin( left, pt.x() );
+			right = qMax( right, pt.x() );
+			top = qMin( top, pt.y() );
+			bottom = qMax( bottom, pt.y() );
+		}
 	}
 
-	QPolygonF polygon( points );
-
-	const QRectF b = polygon.boundingRect();
+	const QRectF b( QPointF( left, top ), QPointF( right, bottom ) );
 
 	const qreal mx = b.width() / MmPx::instance().fromMm( cfg.size().width(), dpi );
 	const qreal my = b.height() / MmPx::instance().fromMm( cfg.size().height(), dpi );
@@ -368,20 +660,15 @@ FormPolyline::draw( QPainter * painter, const Cfg::Polyline & cfg, qreal dpi )
 
 	QPainterPath path;
 
-	for( int i = 0; i < lines.size(); ++i )
+	for( int i = 0; i < points.size(); ++i )
 	{
-		const QLineF line = lines.at( i );
+		const QPointF pt( ( points.at( i ).x() - b.x() ) / mx + b.x() + p.x(),
+			( points.at( i ).y() - b.y() ) / my + b.y() + p.y() );
 
 		if( i == 0 )
-		{
-			path.moveTo( QPointF(
-				( line.p1().x() - b.x() ) / mx + b.x() + p.x(),
-				( line.p1().y() - b.y() ) / my + b.y() + p.y() ) );
-		}
-
-		path.lineTo( QPointF(
-			( line.p2().x() - b.x() ) / mx + b.x() + p.x(),
-			( line.p2().y() - b.y() ) / my + b.y() + p.y() ) );
+			path.moveTo( pt );
+		else
+			path.lineTo( pt );
 	}
 
 	painter->setPen( Cfg::fromPen( cfg.pen(), dpi ) );
@@ -391,81 +678,204 @@ FormPolyline::draw( QPainter * painter, const Cfg::Polyline & cfg, qreal dpi )
 	painter->drawPath( path );
 }
 
-const QList< QLineF > &
+QList< QLineF >
 FormPolyline::lines() const
 {
-	return d->m_lines;
+	QList< QLineF > res;
+	res.reserve( countOfLines() );
+
+	for( int i = 1; i < d->m_points.size(); ++i )
+		res.append( QLineF( d->m_points.at( i - 1 ), d->m_points.at( i ) ) );
+
+	return res;
+}
+
+const QVector< QPointF > &
+FormPolyline::points() const
+{
+	return d->m_points;
 }
 
 void
-FormPolyline::setLines( const QList< QLineF > & lns )
+FormPolyline::setPoints( const QVector< QPointF > & points )
 {
-	d->m_closed = false;
+	const QRectF resized = d->m_resized;
+	const bool isRaw = d->m_isRawPath;
 
-	setBrush( Qt::transparent );
+	d->m_points = points;
 
-	foreach( const QLineF & line, lns )
-		appendLine( line );
+	d->makePath();
+
+	d->placeEnds();
+
+	if( !isRaw )
+		d->updateLines( d->m_resized, resized );
+
+	update();
 }
 
-void
-FormPolyline::appendLine( const QLineF & line )
+//! \return Mask of vertices kept by Douglas-Peucker simplification.
+static inline QVector< bool > simplifiedMask( const QVector< QPointF > & points,
+	qreal tolerance )
 {
-	if( d->m_lines.isEmpty() )
-		d->m_start->setPos( line.p1() -
-			QPointF( d->m_start->halfOfSize(), d->m_start->halfOfSize() ) +
-			pos() );
+	QVector< bool > keep( points.size(), false );
+	keep.first() = true;
+	keep.last() = true;
+
+	QVector< QPair< int, int > > ranges;
+	ranges.append( qMakePair( 0, points.size() - 1 ) );
 
-	if( d->m_lines.isEmpty() || d->m_lines.last().p2() == line.p1() )
+	while( !ranges.isEmpty() )
 	{
-		d->m_lines.append( line );
+		const QPair< int, int > r = ranges.takeLast();
 
-		d->makePath();
+		const QLineF chord( points.at( r.first ), points.at( r.second ) );
+
+		qreal maxDistance = 0.0;
+		int index = -1;
+
+		for( int i = r.first + 1; i < r.second; ++i )
+		{
+			const qreal distance = distanceToSegment( points.at( i ), chord );
 
-		d->m_end->setPos( line.p2() -
-			QPointF( d->m_end->halfOfSize(), d->m_end->halfOfSize() ) + pos() );
+			if( distance > maxDistance )
+			{
+				maxDistance = distance;
+				index = i;
+			}
+		}
+
+		if( index != -1 && maxDistance > tolerance )
+		{
+			keep[ index ] = true;
+
+			ranges.append( qMakePair( r.first, index ) );
+			ranges.append( qMakePair( index, r.second ) );
+		}
 	}
-	else
+
+	return keep;
+}
+
+//! \return Vertices kept by the mask.
+static inline QVector< QPointF > keptPoints( const QVector< QPointF > & points,
+	const QVector< bool > & keep )
+{
+	QVector< QPointF > res;
+	res.reserve( keep.count( true ) );
+
+	for( int i = 0; i < points.size(); ++i )
 	{
-		d->m_lines.prepend( QLineF( line.p2(), line.p1() ) );
+		if( keep.at( i ) )
+			res.append( points.at( i ) );
+	}
 
+	// Closed polyline should stay closed.
+	if( points.first() == points.last() && res.size() < 4 )
+		return points;
+
+	return res;
+}
+
+QVector< QPointF >
+FormPolyline::simplified( const QVector< QPointF > & points, qreal tolerance )
+{
+	if( points.size() < 3 )
+		return points;
+
+	return keptPoints( points, simplifiedMask( points, tolerance ) );
+}
+
+QVector< QPointF >
+FormPolyline::simplified( qreal tolerance ) const
+{
+	if( d->m_points.size() < 3 )
+		return d->m_points;
+
+	// Vertices are stored in the original bounds and drawn stretched
+	// to the resized rectangle, so measure distances as displayed.
+	const QRectF b = d->boundingRect();
+
+	const qreal sx = ( d->m_isRawPath || qFuzzyIsNull( b.width() ) ?
+		1.0 : d->m_resized.width() / b.width() );
+	const qreal sy = ( d->m_isRawPath || qFuzzyIsNull( b.height() ) ?
+		1.0 : d->m_resized.height() / b.height() );
+
+	QVector< QPointF > displayed;
+	displayed.reserve( d->m_points.size() );
+
+	for( const auto & pt : qAsConst( d->m_points ) )
+		displayed.append( QPointF( pt.x() * sx, pt.y() * sy ) );
+
+	return keptPoints( d->m_points, simplifiedMask( displayed, tolerance ) );
+}
+
+void
+FormPolyline::setLines( const QList< QLineF > & lns )
+{
+	d->m_closed = false;
+
+	setBrush( Qt::transparent );
+
+	foreach( const QLineF & line, lns )
+		d->addLine( line );
+
+	d->makePath();
+
+	d->placeEnds();
+}
+
+void
+FormPolyline::appendLine( const QLineF & line )
+{
+	if( d->addLine( line ) )
+		d->appendToPath( line );
+	else
 		d->makePath();
 
-		d->m_start->setPos( line.p2() -
-			QPointF( d->m_start->halfOfSize(), d->m_start->halfOfSize() ) +
-			pos() );
-	}
+	d->placeEnds();
+}
+
+//! \return Is segment the given line in any direction?
+static inline bool isSameSegment( const QPointF & p1, const QPointF & p2,
+	const QLineF & line )
+{
+	return ( ( p1 == line.p1() && p2 == line.p2() ) ||
+		( p1 == line.p2() && p2 == line.p1() ) );
 }
 
 void
 FormPolyline::removeLine( const QLineF & line )
 {
-	if( d->m_lines.first() == line )
-	{
-		d->m_lines.removeFirst();
+	const int count = d->m_points.size();
 
-		d->makePath();
+	if( count < 2 )
+		return;
 
-		d->m_start->setPos( d->m_lines.first().p1() -
-			QPointF( d->m_start->halfOfSize(), d->m_start->halfOfSize() ) +
-			pos() );
+	if( isSameSegment( d->m_points.at( count - 2 ), d->m_points.at( count - 1 ),
+		line ) )
+	{
+		d->m_points.removeLast();
 	}
-	else if( d->m_lines.last() == line )
+	else if( isSameSegment( d->m_points.at( 0 ), d->m_points.at( 1 ), line ) )
 	{
-		d->m_lines.removeLast();
+		d->m_points.removeFirst();
+	}
+	else
+		return;
 
-		d->makePath();
+	if( d->m_points.size() < 2 )
+		d->m_points.clear();
 
-		d->m_end->setPos( d->m_lines.last().p2() -
-			QPointF( d->m_start->halfOfSize(), d->m_start->halfOfSize() ) +
-			pos() );
-	}
+	d->makePath();
+
+	d->placeEnds();
 }
 
 int
 FormPolyline::countOfLines() const
 {
-	return d->m_lines.count();
+	return ( d->m_points.size() > 1 ? d->m_points.size() - 1 : 0 );
 }
 
 void
@@ -524,6 +934,8 @@ FormPolyline::setObjectPen( const QPen & p, bool pushUndoCommand )
 
 	setPen( newPen );
 
+	d->m_isShapeValid = false;
+
 	update();
 }
 
@@ -541,7 +953,37 @@ FormPolyline::setObjectBrush( const QBrush & b, bool pushUndoCommand )
 QRectF
 FormPolyline::boundingRect() const
 {
-	return QGraphicsPathItem::boundingRect();
+	// Path item strokes the whole path for its bounding rect.
+	const qreal w = ( pen().style() == Qt::NoPen ? 0.0 :
+		pen().widthF() / c_halfDivider );
+
+	return d->m_pathBounds.adjusted( -w, -w, w, w );
+}
+
+QPainterPath
+FormPolyline::shape() const
+{
+	if( !d->m_isShapeValid )
+	{
+		d->m_shape = QGraphicsPathItem::shape();
+		d->m_isShapeValid = true;
+	}
+
+	return d->m_shape;
+}
+
+bool
+FormPolyline::contains( const QPointF & point ) const
+{
+	// Filled polyline contains its area, so ask the shape.
+	if( d->m_closed )
+		return shape().contains( point );
+
+	if( !d->m_index.isValid() )
+		d->m_index.build( path() );
+
+	return d->m_index.contains( point,
+		qMax( objectPen().widthF() / c_halfDivider, 0.5 ) );
 }
 
 void
@@ -558,21 +1000,23 @@ FormPolyline::paint( QPainter * painter, const QStyleOptionGraphicsItem * option
 	QWidget * widget )
 {
 	QGraphicsPathItem::paint( painter, option, widget );
+}
 
-	if( isSelected() && !group() )
+QVariant
+FormPolyline::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemSelectedHasChanged )
 	{
-		const qreal w = (qreal) objectPen().width() / c_halfDivider;
-
-		d->m_handles->place( d->m_resized.adjusted(
-			-c_halfHandleSize * c_halfDivider * c_halfDivider - w,
-			-c_halfHandleSize * c_halfDivider * c_halfDivider - w,
-			c_halfHandleSize * c_halfDivider * c_halfDivider + w,
-			c_halfHandleSize * c_halfDivider * c_halfDivider + w ) );
-
-		d->m_handles->show();
+		if( value.toBool() && !group() )
+		{
+			d->placeHandles();
+			d->m_handles->show();
+		}
+		else
+			d->m_handles->hide();
 	}
-	else
-		d->m_handles->hide();
+
+	return QGraphicsPathItem::itemChange( change, value );
 }
 
 void
@@ -735,9 +1179,9 @@ FormPolyline::handleReleased( FormMoveHandle * handle )
 }
 
 FormObject *
-FormPolyline::clone() const
+FormPolyline::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormPolyline( page(), parentItem() );
+	auto * o = new FormPolyline( page(), ( parent ? parent : parentItem() ) );
 
 	o->setCfg( cfg() );
 
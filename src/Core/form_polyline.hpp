@@ -26,6 +26,7 @@
 // Qt include.
 #include <QGraphicsPathItem>
 #include <QScopedPointer>
+#include <QVector>
 
 // Prototyper include.
 #include "form_object.hpp"
@@ -69,7 +70,18 @@ public:
 	static void draw( QPainter * painter, const Cfg::Polyline & cfg, qreal dpi );
 
 	//! \return Lines.
-	const QList< QLineF > & lines() const;
+	QList< QLineF > lines() const;
+	//! \return Vertices.
+	const QVector< QPointF > & points() const;
+	//! Set vertices.
+	void setPoints( const QVector< QPointF > & points );
+	//! \return Vertices simplified with the given tolerance
+	//! (Douglas-Peucker).
+	static QVector< QPointF > simplified( const QVector< QPointF > & points,
+		qreal tolerance );
+	//! \return Vertices simplified with the given tolerance
+	//! measured in displayed (resized) coordinates.
+	QVector< QPointF > simplified( qreal tolerance ) const;
 	//! Set lines.
 	void setLines( const QList< QLineF > & lns );
 	//! Append line.
@@ -94,6 +106,8 @@ public:
 	void setObjectBrush( const QBrush & b, bool pushUndoCommand = true ) override;
 
 	QRectF boundingRect() const override;
+	QPainterPath shape() const override;
+	bool contains( const QPointF & point ) const override;
 
 	//! Handle mouse move in handles.
 	void handleMouseMoveInHandles( const QPointF & p );
@@ -112,7 +126,7 @@ public:
 	void setRectangle( const QRectF & rect, bool pushUndoCommand = true ) override;
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 protected:
 	//! Handle moved.
@@ -120,6 +134,9 @@ protected:
 	//! Handle released.
 	void handleReleased( FormMoveHandle * handle ) override;
 
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
+
 private:
 	Q_DISABLE_COPY( FormPolyline )
 
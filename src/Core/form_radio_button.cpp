@@ -28,6 +28,7 @@
 #include "form_undo_commands.hpp"
 #include "form_checkbox_private.hpp"
 #include "constants.hpp"
+#include "utils.hpp"
 
 // Qt include.
 #include <QWidget>
@@ -62,20 +63,21 @@ FormRadioButton::paint( QPainter * painter,
 	Q_UNUSED( option )
 	Q_UNUSED( widget )
 
-	draw( painter,
-		objectPen(),
-		objectBrush(),
-		d->m_font,
-		QRectF( 0.0, 0.0, d->m_rect.width(), d->m_rect.height() ),
-		d->m_width,
-		d->m_checked,
-		d->m_text,
-		boundingRect() );
-
-	if( isSelected() && !group() )
-		d->m_handles->show();
+	const qreal lod = levelOfDetail( painter );
+
+	if( isLowDetail( lod, d->m_rect.height() ) )
+		drawLowDetail( painter, d->m_rect, objectPen(), objectBrush() );
 	else
-		d->m_handles->hide();
+		draw( painter,
+			objectPen(),
+			objectBrush(),
+			d->m_font,
+			QRectF( 0.0, 0.0, d->m_rect.width(), d->m_rect.height() ),
+			d->m_width,
+			d->m_checked,
+			( isLowDetail( lod, d->m_font.pixelSize(), c_lodMinTextSize ) ?
+				QString() : d->m_text ),
+			boundingRect() );
 }
 
 void
@@ -123,9 +125,10 @@ FormRadioButton::typeName() const
 }
 
 FormObject *
-FormRadioButton::clone() const
+FormRadioButton::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormRadioButton( rectangle(), page(), parentItem() );
+	auto * o = new FormRadioButton( rectangle(), page(),
+		( parent ? parent : parentItem() ) );
 
 	o->setCfg( cfg() );
 
@@ -61,7 +61,7 @@ public:
 	QString typeName() const override;
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 private:
 	Q_DISABLE_COPY( FormRadioButton )
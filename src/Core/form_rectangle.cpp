@@ -202,11 +202,20 @@ FormRect::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	painter->setBrush( objectBrush() );
 
 	painter->drawRect( d->m_rect );
+}
 
-	if( isSelected() && !group() )
-		d->m_handles->show();
-	else
-		d->m_handles->hide();
+QVariant
+FormRect::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemSelectedHasChanged )
+	{
+		if( value.toBool() && !group() )
+			d->m_handles->show();
+		else
+			d->m_handles->hide();
+	}
+
+	return QGraphicsItem::itemChange( change, value );
 }
 
 void
@@ -371,9 +380,9 @@ FormRect::handleReleased( FormMoveHandle * handle )
 }
 
 FormObject *
-FormRect::clone() const
+FormRect::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormRect( page(), parentItem() );
+	auto * o = new FormRect( page(), ( parent ? parent : parentItem() ) );
 
 	o->setCfg( cfg() );
 
@@ -86,7 +86,7 @@ public:
 	void setObjectBrush( const QBrush & b, bool pushUndoCommand = true ) override;
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 protected:
 	//! Handle moved.
@@ -94,6 +94,9 @@ protected:
 	//! Handle released.
 	void handleReleased( FormMoveHandle * handle ) override;
 
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
+
 private:
 	Q_DISABLE_COPY( FormRect )
 
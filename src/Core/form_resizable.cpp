@@ -90,7 +90,8 @@ FormResizableProxyPrivate::init()
 
 	m_handles->setMinSize( QSizeF( c_minResizableSize, c_minResizableSize ) );
 
-	m_handles->show();
+	// Handles will be created when the object will be selected.
+	q->hide();
 
 	q->setZValue( c_mostTopZValue );
 }
@@ -101,6 +102,18 @@ FormResizableProxyPrivate::place( const QRectF & rect )
 	m_handles->place( rect );
 }
 
+void
+FormResizableProxyPrivate::showHandles()
+{
+	m_handles->show();
+}
+
+void
+FormResizableProxyPrivate::hideHandles()
+{
+	m_handles->hide();
+}
+
 
 //
 // FormResizableProxy
@@ -185,6 +198,20 @@ FormResizableProxy::paint( QPainter * painter,
 	Q_UNUSED( option )
 }
 
+QVariant
+FormResizableProxy::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemVisibleHasChanged && !d.isNull() )
+	{
+		if( value.toBool() )
+			d->showHandles();
+		else
+			d->hideHandles();
+	}
+
+	return QGraphicsItem::itemChange( change, value );
+}
+
 void
 FormResizableProxy::handleMoved( const QPointF & delta, FormMoveHandle * handle )
 {
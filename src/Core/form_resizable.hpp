@@ -95,6 +95,9 @@ protected:
 		QGraphicsItem * parent );
 
 protected:
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
+
 	//! Handle moved.
 	void handleMoved( const QPointF & delta, FormMoveHandle * handle ) override;
 	//! Handle released.
@@ -54,6 +54,10 @@ public:
 	virtual void init();
 	//! Place handles.
 	virtual void place( const QRectF & rect );
+	//! Show handles, they are created on demand.
+	virtual void showHandles();
+	//! Hide handles, they are released if not in use.
+	virtual void hideHandles();
 
 	//! Parent.
 	FormResizableProxy * q;
@@ -112,11 +112,15 @@ FormSpinBoxPrivate::init()
 		false );
 
 	q->setObjectBrush( QBrush( PageAction::instance()->fillColor() ), false );
+
+	updateRenderCache( q, false );
 }
 
 void
 FormSpinBoxPrivate::setRect( const QRectF & rect )
 {
+	q->prepareGeometryChange();
+
 	m_rect = rect;
 
 	q->setPos( m_rect.topLeft() );
@@ -164,6 +168,17 @@ FormSpinBox::FormSpinBox( const QRectF & rect, Page * page,
 
 FormSpinBox::~FormSpinBox() = default;
 
+void
+FormSpinBox::releaseProperties()
+{
+	d->disconnectProperties();
+
+	d->m_properties = nullptr;
+	d->m_objProps = nullptr;
+	d->m_spinProps = nullptr;
+	d->m_textStyleProps = nullptr;
+}
+
 void
 FormSpinBox::updatePropertiesValues()
 {
@@ -185,12 +200,14 @@ FormSpinBox::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	Q_UNUSED( widget )
 	Q_UNUSED( option )
 
-	draw( painter, d->m_rect, objectPen(), objectBrush(), d->m_font, d->m_text );
+	const qreal lod = levelOfDetail( painter );
 
-	if( isSelected() && !group() )
-		d->m_proxy->show();
+	if( isLowDetail( lod, qMin( d->m_rect.width(), d->m_rect.height() ) ) )
+		drawLowDetail( painter, d->m_rect, objectPen(), objectBrush() );
 	else
-		d->m_proxy->hide();
+		draw( painter, d->m_rect, objectPen(), objectBrush(), d->m_font,
+			( isLowDetail( lod, d->m_font.pixelSize(), c_lodMinTextSize ) ?
+				QString() : d->m_text ) );
 }
 
 void
@@ -294,7 +311,7 @@ FormSpinBox::cfg() const
 	c.set_pen( Cfg::pen( objectPen() ) );
 	c.set_brush( Cfg::brush( objectBrush() ) );
 
-	c.set_text( text() );
+	c.set_text( Cfg::textStyle( text() ) );
 
 	c.set_z( zValue() );
 
@@ -312,63 +329,37 @@ FormSpinBox::setCfg( const Cfg::SpinBox & c )
 		MmPx::instance().fromMmX( c.size().width() ),
 		MmPx::instance().fromMmY( c.size().height() ) ) );
 
-	setText( c.text() );
+	setText( Cfg::textRun( c.text() ) );
 
 	setZValue( c.z() );
 
 	update();
 }
 
-Cfg::TextStyle
+Cfg::TextRun
 FormSpinBox::text() const
 {
-	Cfg::TextStyle textStyle = Cfg::textStyleFromFont( d->m_font );
-	textStyle.style().push_back( Cfg::c_right );
-	textStyle.set_text( d->m_text );
+	Cfg::TextRun run = Cfg::textRunFromFont( d->m_font );
+	run.m_style |= Cfg::RightAlignment;
+	run.m_text = d->m_text;
 
-	return textStyle;
+	return run;
 }
 
 void
-FormSpinBox::setText( const Cfg::TextStyle & c )
+FormSpinBox::setText( const Cfg::TextRun & c )
 {
-	if( std::find( c.style().cbegin(), c.style().cend(),
-		Cfg::c_normalStyle ) != c.style().cend() )
-	{
-		d->m_font.setWeight( QFont::Normal );
-		d->m_font.setItalic( false );
-		d->m_font.setUnderline( false );
-	}
-	else
-	{
-		if( std::find( c.style().cbegin(), c.style().cend(),
-			Cfg::c_boldStyle ) != c.style().cend() )
-				d->m_font.setWeight( QFont::Bold );
-		else
-			d->m_font.setWeight( QFont::Normal );
-
-		if( std::find( c.style().cbegin(), c.style().cend(),
-			Cfg::c_italicStyle ) != c.style().cend() )
-				d->m_font.setItalic( true );
-		else
-			d->m_font.setItalic( false );
-
-		if( std::find( c.style().cbegin(), c.style().cend(),
-			Cfg::c_underlineStyle ) != c.style().cend() )
-				d->m_font.setUnderline( true );
-		else
-			d->m_font.setUnderline( false );
-	}
+	Cfg::initFont( d->m_font, c.m_style );
 
-	d->m_font.setPixelSize( MmPx::instance().fromPtY( c.fontSize() ) );
+	d->m_font.setPixelSize( MmPx::instance().fromPtY( c.m_fontSize ) );
 
-	d->m_text = c.text();
+	d->m_text = c.m_text;
 
 	if( d->m_properties )
 	{
 		d->disconnectProperties();
 		d->m_spinProps->ui()->m_value->setValue( d->m_text.toInt() );
-		d->m_textStyleProps->ui()->m_size->setValue( qRound( c.fontSize() ) );
+		d->m_textStyleProps->ui()->m_size->setValue( qRound( c.m_fontSize ) );
 		d->m_textStyleProps->ui()->m_bold->setChecked( d->m_font.weight() == QFont::Bold );
 		d->m_textStyleProps->ui()->m_italic->setChecked( d->m_font.italic() );
 		d->m_textStyleProps->ui()->m_underline->setChecked( d->m_font.underline() );
@@ -454,6 +445,19 @@ FormSpinBox::moveResizable( const QPointF & delta )
 	moveBy( delta.x(), delta.y() );
 }
 
+QVariant
+FormSpinBox::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemSelectedHasChanged )
+	{
+		updateRenderCache( this, value.toBool() );
+
+		d->m_proxy->setVisible( value.toBool() && !group() );
+	}
+
+	return QGraphicsObject::itemChange( change, value );
+}
+
 QSizeF
 FormSpinBox::defaultSize() const
 {
@@ -461,20 +465,32 @@ FormSpinBox::defaultSize() const
 }
 
 QWidget *
-FormSpinBox::properties( QWidget * parent )
+FormSpinBox::properties( QWidget * parent, QWidget * panel )
 {
-	d->m_properties = new QWidget( parent );
-	d->m_objProps = new ObjectProperties( this, d->m_properties );
-	d->m_spinProps = new SpinBoxProperties( d->m_properties );
-	d->m_textStyleProps = new TextStyleProperties( d->m_properties );
-
-	auto * l = new QVBoxLayout( d->m_properties );
-	l->setMargin( 0 );
-	l->setSpacing( 0 );
-	l->addWidget( d->m_objProps );
-	l->addWidget( d->m_spinProps );
-	l->addWidget( d->m_textStyleProps );
-	l->addSpacerItem( new QSpacerItem( 0, 0, QSizePolicy::Minimum, QSizePolicy::Expanding ) );
+	if( panel )
+	{
+		d->m_properties = panel;
+		d->m_objProps = panel->findChild< ObjectProperties* > ();
+		d->m_objProps->setObject( this );
+		d->m_spinProps = panel->findChild< SpinBoxProperties* > ();
+		d->m_textStyleProps = panel->findChild< TextStyleProperties* > ();
+		d->disconnectProperties();
+	}
+	else
+	{
+		d->m_properties = new QWidget( parent );
+		d->m_objProps = new ObjectProperties( this, d->m_properties );
+		d->m_spinProps = new SpinBoxProperties( d->m_properties );
+		d->m_textStyleProps = new TextStyleProperties( d->m_properties );
+
+		auto * l = new QVBoxLayout( d->m_properties );
+		l->setMargin( 0 );
+		l->setSpacing( 0 );
+		l->addWidget( d->m_objProps );
+		l->addWidget( d->m_spinProps );
+		l->addWidget( d->m_textStyleProps );
+		l->addSpacerItem( new QSpacerItem( 0, 0, QSizePolicy::Minimum, QSizePolicy::Expanding ) );
+	}
 
 	d->m_objProps->ui()->m_x->setValue( pos().x() );
 	d->m_objProps->ui()->m_y->setValue( pos().y() );
@@ -495,9 +511,10 @@ FormSpinBox::properties( QWidget * parent )
 }
 
 FormObject *
-FormSpinBox::clone() const
+FormSpinBox::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormSpinBox( rectangle(), page(), parentItem() );
+	auto * o = new FormSpinBox( rectangle(), page(),
+		( parent ? parent : parentItem() ) );
 
 	o->setCfg( cfg() );
 
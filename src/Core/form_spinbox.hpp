@@ -37,6 +37,12 @@ namespace Prototyper {
 
 namespace Core {
 
+namespace Cfg {
+
+struct TextRun;
+
+} /* namespace Cfg */
+
 class TextWithOpts;
 
 
@@ -82,9 +88,9 @@ public:
 	void setCfg( const Cfg::SpinBox & c );
 
 	//! \return Text.
-	Cfg::TextStyle text() const;
+	Cfg::TextRun text() const;
 	//! Set text.
-	void setText( const Cfg::TextStyle & c );
+	void setText( const Cfg::TextRun & c );
 
 	QRectF boundingRect() const override;
 
@@ -101,12 +107,13 @@ public:
 	//! \return Default size.
 	virtual QSizeF defaultSize() const override;
 
-	QWidget * properties( QWidget * parent ) override;
+	QWidget * properties( QWidget * parent, QWidget * panel ) override;
+	void releaseProperties() override;
 
 	void updatePropertiesValues() override;
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 protected:
 	//! Resize.
@@ -114,6 +121,9 @@ protected:
 	//! Move resizable.
 	void moveResizable( const QPointF & delta ) override;
 
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
+
 private:
 	friend class FormSpinBoxPrivate;
 
@@ -43,6 +43,7 @@
 #include <QKeyEvent>
 #include <QEvent>
 #include <QGraphicsScene>
+#include <QStaticText>
 
 
 namespace Prototyper {
@@ -60,8 +61,9 @@ public:
 		,	m_rect( rect )
 		,	m_proxy( nullptr )
 		,	m_opts( nullptr )
-		,	m_isFirstPaint( true )
 		,	m_showToolBar( false )
+		,	m_isIBeam( false )
+		,	m_isStaticTextValid( false )
 	{
 	}
 
@@ -69,6 +71,22 @@ public:
 	void init();
 	//! Set rect.
 	void setRect( const QRectF & rect );
+	//! \return Rect of the resizable proxy.
+	QRectF proxyRect() const;
+	//! \return Resizable proxy, it's created on demand.
+	FormResizableProxy * proxy();
+	//! Release resizable proxy if it's not in use.
+	void releaseProxy();
+	//! \return Text options, they are created on demand.
+	FormTextOpts * opts();
+	//! Place text options above the text.
+	void placeOpts();
+	//! Release text options.
+	void releaseOpts();
+	//! Update handles, options and cursor for the current state.
+	void updateEditState();
+	//! Draw text with the static layout.
+	void drawStaticText( QPainter * painter );
 
 	//! Parent.
 	FormText * q;
@@ -78,10 +96,14 @@ public:
 	QScopedPointer< FormResizableProxy > m_proxy;
 	//! Text options.
 	QScopedPointer< FormTextOpts > m_opts;
-	//! First paint.
-	bool m_isFirstPaint;
 	//! Show tool bar.
 	bool m_showToolBar;
+	//! Is I-beam cursor set?
+	bool m_isIBeam;
+	//! Layout of the text while it's not edited.
+	QStaticText m_staticText;
+	//! Is static layout up to date?
+	bool m_isStaticTextValid;
 }; // class FormTextPrivate
 
 void
@@ -89,21 +111,12 @@ FormTextPrivate::init()
 {
 	q->enableEditing( true );
 
-	m_proxy.reset( new FormResizableProxy( q, q->parentItem(), q->page() ) );
-
-	m_opts.reset( new FormTextOpts( q->parentItem() ) );
-
-	m_opts->hide();
-	m_opts->setZValue( c_mostTopZValue );
-
 	setRect( m_rect );
 
 	initDefaultFont( q );
 
 	q->setPlainText( FormText::tr( "Text" ) );
 
-	m_proxy->setMinSize( q->minimumSize() );
-
 	q->setObjectPen( QPen( PageAction::instance()->strokeColor() ),
 		false );
 
@@ -111,6 +124,65 @@ FormTextPrivate::init()
 
 	FormText::connect( q->document(), &QTextDocument::contentsChanged,
 		q, &FormText::p_contentChanged );
+
+	updateRenderCache( q, false );
+
+	q->p_contentChanged();
+
+	updateEditState();
+}
+
+QRectF
+FormTextPrivate::proxyRect() const
+{
+	QRectF r = q->boundingRect();
+	const auto s = q->minimumSize();
+	r.setHeight( qMax( s.height(), r.height() ) );
+	r.setWidth( qMax( s.width(), r.width() ) );
+	r.moveTo( q->pos() );
+
+	return r;
+}
+
+FormResizableProxy *
+FormTextPrivate::proxy()
+{
+	if( m_proxy )
+		return m_proxy.data();
+
+	m_proxy.reset( new FormResizableProxy( q, q->parentItem(), q->page() ) );
+	m_proxy->setMinSize( q->minimumSize() );
+	m_proxy->setRect( proxyRect() );
+
+	return m_proxy.data();
+}
+
+void
+FormTextPrivate::releaseProxy()
+{
+	if( !m_proxy )
+		return;
+
+	const QGraphicsItem * grabber = ( q->scene() ?
+		q->scene()->mouseGrabberItem() : nullptr );
+
+	if( grabber && m_proxy->isAncestorOf( grabber ) )
+		m_proxy->hide();
+	else
+		m_proxy.reset();
+}
+
+FormTextOpts *
+FormTextPrivate::opts()
+{
+	if( m_opts )
+		return m_opts.data();
+
+	m_opts.reset( new FormTextOpts( q->parentItem() ) );
+
+	m_opts->hide();
+	m_opts->setZValue( c_mostTopZValue );
+
 	FormText::connect( m_opts.data(), &FormTextOpts::setFontSize,
 		q, &FormText::setFontSize );
 	FormText::connect( m_opts.data(), &FormTextOpts::bold,
@@ -129,6 +201,79 @@ FormTextPrivate::init()
 		q, &FormText::alignCenter );
 	FormText::connect( m_opts.data(), &FormTextOpts::alignRight,
 		q, &FormText::alignRight );
+
+	m_opts->updateState( q->textCursor() );
+
+	return m_opts.data();
+}
+
+void
+FormTextPrivate::placeOpts()
+{
+	if( m_opts )
+		m_opts->setPos( q->pos() + QPointF( 0.0, -m_opts->size().height() ) );
+}
+
+void
+FormTextPrivate::releaseOpts()
+{
+	// Options may be released from their own signal.
+	if( m_opts )
+		m_opts.take()->deleteLater();
+}
+
+void
+FormTextPrivate::updateEditState()
+{
+	const bool isFree = !q->group();
+	const bool isIBeam = isFree && !q->isSelected();
+
+	if( isIBeam != m_isIBeam )
+	{
+		if( isIBeam )
+			q->setCursor( Qt::IBeamCursor );
+		else
+			q->unsetCursor();
+
+		m_isIBeam = isIBeam;
+	}
+
+	if( isFree && q->isSelected() )
+		proxy()->show();
+	else
+		releaseProxy();
+
+	if( isFree && !q->isSelected() && m_showToolBar )
+	{
+		opts();
+
+		placeOpts();
+
+		m_opts->show();
+	}
+	else if( m_opts )
+		m_opts->hide();
+}
+
+void
+FormTextPrivate::drawStaticText( QPainter * painter )
+{
+	const qreal margin = q->document()->documentMargin();
+
+	if( !m_isStaticTextValid )
+	{
+		m_staticText.setTextFormat( Qt::RichText );
+		m_staticText.setText( q->document()->toHtml() );
+		m_staticText.setTextWidth( q->textWidth() < 0.0 ?
+			-1.0 : q->textWidth() - margin * c_halfDivider );
+
+		m_isStaticTextValid = true;
+	}
+
+	painter->setFont( q->document()->defaultFont() );
+	painter->setPen( q->defaultTextColor() );
+
+	painter->drawStaticText( QPointF( margin, margin ), m_staticText );
 }
 
 void
@@ -140,13 +285,12 @@ FormTextPrivate::setRect( const QRectF & rect )
 
 	q->setTextWidth( m_rect.width() );
 
-	QRectF r = q->boundingRect();
-	const auto s = q->minimumSize();
-	r.setHeight( qMax( s.height(), r.height() ) );
-	r.setWidth( qMax( s.width(), r.width() ) );
-	r.moveTo( q->pos() );
+	m_isStaticTextValid = false;
 
-	m_proxy->setRect( r );
+	if( m_proxy )
+		m_proxy->setRect( proxyRect() );
+
+	placeOpts();
 }
 
 
@@ -171,6 +315,12 @@ FormText::clearEditMode()
 
 	d->m_showToolBar = false;
 
+	d->releaseOpts();
+
+	d->updateEditState();
+
+	updateRenderCache( this, false );
+
 	update();
 }
 
@@ -215,6 +365,9 @@ FormText::setCfg( const Cfg::Text & c )
 
 	setDocument( doc );
 
+	connect( doc, &QTextDocument::contentsChanged,
+		this, &FormText::p_contentChanged );
+
 	document()->clearUndoRedoStacks();
 
 	initDefaultFont( this );
@@ -255,40 +408,25 @@ void
 FormText::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	QWidget * widget )
 {
-	if( d->m_isFirstPaint )
-	{
-		p_contentChanged();
-
-		d->m_isFirstPaint = false;
-	}
-
-	QGraphicsTextItem::paint( painter, option, widget );
+	const qreal lineHeight = QFontMetricsF( document()->defaultFont() ).lineSpacing();
 
-	if( isSelected() && !group() )
-	{
-		unsetCursor();
-
-		d->m_proxy->show();
-
-		d->m_opts->hide();
-	}
+	if( !hasFocus() && isLowDetail( levelOfDetail( painter ), lineHeight,
+		c_lodMinTextSize ) )
+			drawLowDetailText( painter, boundingRect(), lineHeight,
+				objectPen().color() );
+	else if( hasFocus() || isSelected() )
+		QGraphicsTextItem::paint( painter, option, widget );
 	else
-	{
-		if( !isSelected() && !group() )
-			setCursor( Qt::IBeamCursor );
-
-		if( !group() && d->m_showToolBar )
-		{
-			d->m_opts->setPos( pos() +
-				QPointF( 0.0, -d->m_opts->size().height() ) );
+		d->drawStaticText( painter );
+}
 
-			d->m_opts->show();
-		}
-		else
-			d->m_opts->hide();
+QVariant
+FormText::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemSelectedHasChanged || change == ItemParentHasChanged )
+		d->updateEditState();
 
-		d->m_proxy->hide();
-	}
+	return QGraphicsTextItem::itemChange( change, value );
 }
 
 void
@@ -334,6 +472,8 @@ FormText::setObjectPen( const QPen & p, bool pushUndoCommand )
 
 	setDefaultTextColor( p.color() );
 
+	d->m_isStaticTextValid = false;
+
 	update();
 }
 
@@ -469,7 +609,8 @@ FormText::changeTextColor()
 void
 FormText::p_cursorChanged( const QTextCursor & cursor )
 {
-	d->m_opts->updateState( cursor );
+	if( d->m_opts )
+		d->m_opts->updateState( cursor );
 }
 
 void
@@ -558,6 +699,10 @@ FormText::focusInEvent( QFocusEvent * e )
 
 	d->m_showToolBar = true;
 
+	updateRenderCache( this, true );
+
+	d->updateEditState();
+
 	QGraphicsTextItem::focusInEvent( e );
 }
 
@@ -624,14 +769,35 @@ FormText::keyReleaseEvent( QKeyEvent * event )
 }
 
 FormObject *
-FormText::clone() const
+FormText::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormText( rectangle(), page(), parentItem() );
-
-	o->setCfg( cfg() );
+	auto * o = new FormText( rectangle(), page(),
+		( parent ? parent : parentItem() ) );
 
 	o->setObjectId( page()->nextId() );
 
+	o->setPlainText( QString() );
+
+	o->setDocument( document()->clone( o ) );
+
+	o->document()->clearUndoRedoStacks();
+
+	initDefaultFont( o );
+
+	FormText::connect( o->document(), &QTextDocument::contentsChanged,
+		o, &FormText::p_contentChanged );
+
+	o->setTextWidth( textWidth() );
+
+	o->setPos( pos() );
+
+	o->setZValue( zValue() );
+
+	QRectF r = o->boundingRect();
+	r.moveTo( o->pos() );
+
+	o->d->setRect( r );
+
 	return o;
 }
 
@@ -95,7 +95,7 @@ public:
 	QSizeF minimumSize() const override;
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 public slots:
 	//! Set font size.
@@ -137,6 +137,9 @@ protected:
 	void mouseReleaseEvent( QGraphicsSceneMouseEvent * event ) override;
 	void keyReleaseEvent( QKeyEvent * event ) override;
 
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
+
 private:
 	friend class FormTextPrivate;
 
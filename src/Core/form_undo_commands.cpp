@@ -31,6 +31,83 @@ namespace Prototyper {
 
 namespace Core {
 
+//! \return Approximate memory used by the configurations.
+template< class Container >
+static inline qint64 undoPayloadSizeOfAll( const Container & c )
+{
+	qint64 size = 0;
+
+	for( const auto & i : c )
+		size += undoPayloadSize( i );
+
+	return size;
+}
+
+qint64
+undoPayloadSize( const Cfg::TextStyle & c )
+{
+	return sizeof( Cfg::TextStyle ) +
+		( c.text().size() + c.link().size() ) * qint64( sizeof( QChar ) );
+}
+
+qint64
+undoPayloadSize( const Cfg::Text & c )
+{
+	return sizeof( Cfg::Text ) + undoPayloadSizeOfAll( c.text() );
+}
+
+qint64
+undoPayloadSize( const Cfg::Polyline & c )
+{
+	return sizeof( Cfg::Polyline ) +
+		qint64( c.coordinates().size() ) * qint64( sizeof( qreal ) ) +
+		qint64( c.line().size() ) * qint64( sizeof( Cfg::Line ) );
+}
+
+qint64
+undoPayloadSize( const Cfg::Button & c )
+{
+	return sizeof( Cfg::Button ) + undoPayloadSize( c.text() );
+}
+
+qint64
+undoPayloadSize( const Cfg::CheckBox & c )
+{
+	return sizeof( Cfg::CheckBox ) + undoPayloadSize( c.text() );
+}
+
+qint64
+undoPayloadSize( const Cfg::SpinBox & c )
+{
+	return sizeof( Cfg::SpinBox ) + undoPayloadSize( c.text() );
+}
+
+qint64
+undoPayloadSize( const Cfg::Image & c )
+{
+	return sizeof( Cfg::Image ) + c.data().size() * qint64( sizeof( QChar ) );
+}
+
+qint64
+undoPayloadSize( const Cfg::Group & c )
+{
+	return sizeof( Cfg::Group ) +
+		undoPayloadSizeOfAll( c.line() ) +
+		undoPayloadSizeOfAll( c.polyline() ) +
+		undoPayloadSizeOfAll( c.text() ) +
+		undoPayloadSizeOfAll( c.image() ) +
+		undoPayloadSizeOfAll( c.rect() ) +
+		undoPayloadSizeOfAll( c.button() ) +
+		undoPayloadSizeOfAll( c.checkbox() ) +
+		undoPayloadSizeOfAll( c.radiobutton() ) +
+		undoPayloadSizeOfAll( c.combobox() ) +
+		undoPayloadSizeOfAll( c.spinbox() ) +
+		undoPayloadSizeOfAll( c.hslider() ) +
+		undoPayloadSizeOfAll( c.vslider() ) +
+		undoPayloadSizeOfAll( c.group() );
+}
+
+
 //
 // UndoGroup
 //
@@ -83,6 +160,24 @@ UndoGroup::redo()
 	}
 }
 
+QStringList
+UndoGroup::objectIds() const
+{
+	QStringList ids = m_items;
+	ids.append( m_id );
+
+	// Items are known only after undo, the group knows them before.
+	auto * group = dynamic_cast< FormGroup* > ( m_form->findItem( m_id ) );
+
+	if( group )
+	{
+		foreach( QGraphicsItem * item, group->children() )
+			ids.append( dynamic_cast< FormObject* > ( item )->objectId() );
+	}
+
+	return ids;
+}
+
 
 //
 // UndoUngroup
@@ -126,6 +221,12 @@ UndoUngroup::redo()
 	}
 }
 
+QStringList
+UndoUngroup::objectIds() const
+{
+	return QStringList( m_items ) << m_id;
+}
+
 
 //
 // UndoAddLineToPoly
@@ -219,6 +320,12 @@ UndoAddLineToPoly::redo()
 	}
 }
 
+QStringList
+UndoAddLineToPoly::objectIds() const
+{
+	return QStringList() << m_id;
+}
+
 
 //
 // UndoChangeLine
@@ -264,6 +371,12 @@ UndoChangeLine::redo()
 	}
 }
 
+QStringList
+UndoChangeLine::objectIds() const
+{
+	return QStringList() << m_id;
+}
+
 
 //
 // UndoChangePen
@@ -277,6 +390,7 @@ UndoChangePen::UndoChangePen( Page * form, const QString & id,
 	,	m_oldPen( oldPen )
 	,	m_newPen( newPen )
 	,	m_undone( false )
+	,	m_time( undoTimeStamp() )
 {
 }
 
@@ -308,6 +422,32 @@ UndoChangePen::redo()
 	}
 }
 
+QStringList
+UndoChangePen::objectIds() const
+{
+	return QStringList() << m_id;
+}
+
+int
+UndoChangePen::id() const
+{
+	return UndoChangePenId;
+}
+
+bool
+UndoChangePen::mergeWith( const QUndoCommand * other )
+{
+	const auto * c = static_cast< const UndoChangePen* > ( other );
+
+	if( c->m_id != m_id || !isUndoMergeable( m_time, c->m_time ) )
+		return false;
+
+	m_newPen = c->m_newPen;
+	m_time = c->m_time;
+
+	return true;
+}
+
 
 //
 // UndoChangeBrush
@@ -321,6 +461,7 @@ UndoChangeBrush::UndoChangeBrush( Page * form, const QString & id,
 	,	m_oldBrush( oldBrush )
 	,	m_newBrush( newBrush )
 	,	m_undone( false )
+	,	m_time( undoTimeStamp() )
 {
 }
 
@@ -352,6 +493,32 @@ UndoChangeBrush::redo()
 	}
 }
 
+QStringList
+UndoChangeBrush::objectIds() const
+{
+	return QStringList() << m_id;
+}
+
+int
+UndoChangeBrush::id() const
+{
+	return UndoChangeBrushId;
+}
+
+bool
+UndoChangeBrush::mergeWith( const QUndoCommand * other )
+{
+	const auto * c = static_cast< const UndoChangeBrush* > ( other );
+
+	if( c->m_id != m_id || !isUndoMergeable( m_time, c->m_time ) )
+		return false;
+
+	m_newBrush = c->m_newBrush;
+	m_time = c->m_time;
+
+	return true;
+}
+
 
 //
 // UndoChangeTextOnForm
@@ -394,13 +561,19 @@ UndoChangeTextOnForm::redo()
 	}
 }
 
+QStringList
+UndoChangeTextOnForm::objectIds() const
+{
+	return QStringList() << m_id;
+}
+
 
 //
 // UndoChangeTextWithOpts
 //
 
 UndoChangeTextWithOpts::UndoChangeTextWithOpts( Page * form, const QString & id,
-	const Cfg::TextStyle & oldOpts, const Cfg::TextStyle & newOpts )
+	const Cfg::TextRun & oldOpts, const Cfg::TextRun & newOpts )
 	:	QUndoCommand( QObject::tr( "Change Text Options" ) )
 	,	m_form( form )
 	,	m_id( id )
@@ -431,8 +604,14 @@ UndoChangeTextWithOpts::redo()
 	}
 }
 
+QStringList
+UndoChangeTextWithOpts::objectIds() const
+{
+	return QStringList() << m_id;
+}
+
 void
-UndoChangeTextWithOpts::setTextOpts( const Cfg::TextStyle & opts )
+UndoChangeTextWithOpts::setTextOpts( const Cfg::TextRun & opts )
 {
 	auto * obj = dynamic_cast< FormObject* > ( m_form->findItem( m_id ) );
 
@@ -519,6 +698,12 @@ UndoChangeCheckState::redo()
 	}
 }
 
+QStringList
+UndoChangeCheckState::objectIds() const
+{
+	return QStringList() << m_id;
+}
+
 FormCheckBox *
 UndoChangeCheckState::find() const
 {
@@ -576,6 +761,8 @@ UndoDuplicate::redo()
 			{
 				auto * n = o->clone();
 
+				m_form->updateZOrder( dynamic_cast< QGraphicsItem* > ( n ) );
+
 				n->setPosition( n->position() + QPointF( m_gridStep, m_gridStep ), false );
 
 				m_duplIds.append( n->objectId() );
@@ -586,6 +773,12 @@ UndoDuplicate::redo()
 	}
 }
 
+QStringList
+UndoDuplicate::objectIds() const
+{
+	return m_duplIds;
+}
+
 //
 // UndoChangeZ
 //
@@ -598,6 +791,7 @@ UndoChangeZ::UndoChangeZ( Page * form, const ZAndIds & origZ,
 	,	m_orig( origZ )
 	,	m_new( newZ )
 	,	m_undone( false )
+	,	m_time( undoTimeStamp() )
 {
 }
 
@@ -611,7 +805,10 @@ UndoChangeZ::undo()
 		auto * i = m_form->findItem( p.first );
 
 		if( i )
+		{
 			i->setZValue( p.second );
+			m_form->updateZOrder( i );
+		}
 	}
 
 	TopGui::instance()->projectWindow()->switchToSelectMode();
@@ -627,13 +824,214 @@ UndoChangeZ::redo()
 			auto * i = m_form->findItem( p.first );
 
 			if( i )
+			{
 				i->setZValue( p.second );
+				m_form->updateZOrder( i );
+			}
 		}
 
 		TopGui::instance()->projectWindow()->switchToSelectMode();
 	}
 }
 
+QStringList
+UndoChangeZ::objectIds() const
+{
+	QStringList ids;
+
+	for( const auto & p : qAsConst( m_new ) )
+		ids.append( p.first );
+
+	return ids;
+}
+
+int
+UndoChangeZ::id() const
+{
+	return UndoChangeZId;
+}
+
+bool
+UndoChangeZ::mergeWith( const QUndoCommand * other )
+{
+	const auto * c = static_cast< const UndoChangeZ* > ( other );
+
+	if( !isUndoMergeable( m_time, c->m_time ) || c->m_new.size() != m_new.size() )
+		return false;
+
+	for( int i = 0; i < m_new.size(); ++i )
+	{
+		if( c->m_new.at( i ).first != m_new.at( i ).first )
+			return false;
+	}
+
+	m_new = c->m_new;
+	m_time = c->m_time;
+
+	return true;
+}
+
+
+//
+// UndoMoveMany
+//
+
+UndoMoveMany::UndoMoveMany( Page * form, const DeltaAndIds & deltas,
+	const QString & text )
+	:	QUndoCommand( text )
+	,	m_form( form )
+	,	m_deltas( deltas )
+	,	m_undone( false )
+	,	m_time( undoTimeStamp() )
+{
+}
+
+void
+UndoMoveMany::undo()
+{
+	m_undone = true;
+
+	move( -1.0 );
+}
+
+void
+UndoMoveMany::redo()
+{
+	if( m_undone )
+		move( 1.0 );
+}
+
+QStringList
+UndoMoveMany::objectIds() const
+{
+	QStringList ids;
+
+	for( const auto & p : qAsConst( m_deltas ) )
+		ids.append( p.first );
+
+	return ids;
+}
+
+int
+UndoMoveMany::id() const
+{
+	return UndoMoveManyId;
+}
+
+bool
+UndoMoveMany::mergeWith( const QUndoCommand * other )
+{
+	const auto * c = static_cast< const UndoMoveMany* > ( other );
+
+	if( c->text() != text() || !isUndoMergeable( m_time, c->m_time ) ||
+		c->m_deltas.size() != m_deltas.size() )
+			return false;
+
+	for( int i = 0; i < m_deltas.size(); ++i )
+	{
+		if( c->m_deltas.at( i ).first != m_deltas.at( i ).first )
+			return false;
+	}
+
+	for( int i = 0; i < m_deltas.size(); ++i )
+		m_deltas[ i ].second += c->m_deltas.at( i ).second;
+
+	m_time = c->m_time;
+
+	return true;
+}
+
+void
+UndoMoveMany::move( qreal sign )
+{
+	for( const auto & p : qAsConst( m_deltas ) )
+	{
+		auto * obj = dynamic_cast< FormObject* > ( m_form->findItem( p.first ) );
+
+		if( obj )
+			obj->setPosition( obj->position() + p.second * sign, false );
+	}
+
+	TopGui::instance()->projectWindow()->switchToSelectMode();
+}
+
+
+//
+// UndoChangePoints
+//
+
+UndoChangePoints::UndoChangePoints( Page * form, const PointsAndIds & origPoints,
+	const PointsAndIds & newPoints, const QString & text )
+	:	QUndoCommand( text )
+	,	m_form( form )
+	,	m_orig( origPoints )
+	,	m_new( newPoints )
+	,	m_undone( false )
+{
+}
+
+void
+UndoChangePoints::undo()
+{
+	m_undone = true;
+
+	setPoints( m_orig );
+}
+
+void
+UndoChangePoints::redo()
+{
+	if( m_undone )
+		setPoints( m_new );
+}
+
+QStringList
+UndoChangePoints::objectIds() const
+{
+	QStringList ids;
+
+	for( const auto & p : qAsConst( m_new ) )
+		ids.append( p.first );
+
+	return ids;
+}
+
+qint64
+UndoChangePoints::payloadSize() const
+{
+	qint64 size = sizeof( UndoChangePoints );
+
+	for( const auto & p : m_orig )
+		size += p.second.size() * qint64( sizeof( QPointF ) );
+
+	for( const auto & p : m_new )
+		size += p.second.size() * qint64( sizeof( QPointF ) );
+
+	return size;
+}
+
+void
+UndoChangePoints::releasePayload()
+{
+	m_orig.clear();
+	m_new.clear();
+}
+
+void
+UndoChangePoints::setPoints( const PointsAndIds & points )
+{
+	for( const auto & p : points )
+	{
+		auto * poly = dynamic_cast< FormPolyline* > (
+			m_form->findItem( p.first ) );
+
+		if( poly )
+			poly->setPoints( p.second );
+	}
+
+	TopGui::instance()->projectWindow()->switchToSelectMode();
+}
+
 } /* namespace Core */
 
 } /* namespace Prototyper */
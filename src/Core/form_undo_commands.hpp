@@ -25,9 +25,11 @@
 
 // Qt include.
 #include <QUndoCommand>
+#include <QSharedPointer>
 #include <QList>
 #include <QObject>
 #include <QPointer>
+#include <QDateTime>
 
 // Prototyper include.
 #include "page.hpp"
@@ -48,6 +50,8 @@
 #include "top_gui.hpp"
 #include "project_window.hpp"
 #include "project_cfg.hpp"
+#include "constants.hpp"
+#include "utils.hpp"
 
 
 QT_BEGIN_NAMESPACE
@@ -59,6 +63,97 @@ namespace Prototyper {
 
 namespace Core {
 
+//! Ids of undo commands that can be merged.
+enum UndoCommandId {
+	//! Move.
+	UndoMoveId = 1,
+	//! Resize.
+	UndoResizeId,
+	//! Change pen.
+	UndoChangePenId,
+	//! Change brush.
+	UndoChangeBrushId,
+	//! Change Z.
+	UndoChangeZId,
+	//! Move of several objects.
+	UndoMoveManyId
+}; // enum UndoCommandId
+
+//! \return Current time for merging of undo commands.
+inline qint64 undoTimeStamp()
+{
+	return QDateTime::currentMSecsSinceEpoch();
+}
+
+//! \return Is command made at \a next time can be merged with the one made
+//! at \a prev time.
+inline bool isUndoMergeable( qint64 prev, qint64 next )
+{
+	return ( next - prev <= c_undoMergeInterval );
+}
+
+//! \return Approximate memory used by the configuration.
+template< class Config >
+inline qint64 undoPayloadSize( const Config & )
+{
+	return sizeof( Config );
+}
+
+//! \return Approximate memory used by the text run.
+qint64 undoPayloadSize( const Cfg::TextStyle & c );
+
+//! \return Approximate memory used by the text configuration.
+qint64 undoPayloadSize( const Cfg::Text & c );
+
+//! \return Approximate memory used by the polyline configuration.
+qint64 undoPayloadSize( const Cfg::Polyline & c );
+
+//! \return Approximate memory used by the button configuration.
+qint64 undoPayloadSize( const Cfg::Button & c );
+
+//! \return Approximate memory used by the check box configuration.
+qint64 undoPayloadSize( const Cfg::CheckBox & c );
+
+//! \return Approximate memory used by the spin box configuration.
+qint64 undoPayloadSize( const Cfg::SpinBox & c );
+
+//! \return Approximate memory used by the image configuration.
+qint64 undoPayloadSize( const Cfg::Image & c );
+
+//! \return Approximate memory used by the group configuration.
+qint64 undoPayloadSize( const Cfg::Group & c );
+
+
+//
+// UndoPayload
+//
+
+//! Base of undo commands that keep configurations of objects.
+class UndoPayload {
+public:
+	virtual ~UndoPayload() = default;
+
+	//! \return Approximate memory used by the command.
+	virtual qint64 payloadSize() const = 0;
+	//! Release configurations, the command is obsolete after it.
+	virtual void releasePayload() = 0;
+}; // class UndoPayload
+
+
+//
+// UndoObjects
+//
+
+//! Base of undo commands that know which objects they change.
+class UndoObjects {
+public:
+	virtual ~UndoObjects() = default;
+
+	//! \return Ids of objects changed by the last undo or redo.
+	virtual QStringList objectIds() const = 0;
+}; // class UndoObjects
+
+
 //
 // UndoCreate
 //
@@ -67,6 +162,8 @@ namespace Core {
 template< class Elem, class Config >
 class UndoCreate final
 	:	public QUndoCommand
+	,	public UndoPayload
+	,	public UndoObjects
 {
 public:
 	UndoCreate( Page * f, const QString & id )
@@ -83,7 +180,9 @@ public:
 
 		Elem * elem = dynamic_cast< Elem* > ( m_form->findItem( m_id ) );
 
-		m_cfg = elem->cfg();
+		// Element may be changed without undo commands since the last
+		// redo, so snapshot it on each undo.
+		m_cfg.reset( new Config( elem->cfg() ) );
 
 		m_form->deleteItems( QList< QGraphicsItem* > () << elem, false );
 
@@ -115,15 +214,30 @@ public:
 			Elem * elem = dynamic_cast< Elem* > (
 				m_form->createElement< Elem >( m_id ) );
 
-			elem->setCfg( m_cfg );
+			elem->setCfg( *m_cfg );
 
 			TopGui::instance()->projectWindow()->switchToSelectMode();
 		}
 	}
 
+	qint64 payloadSize() const override
+	{
+		return ( m_cfg ? undoPayloadSize( *m_cfg ) : 0 );
+	}
+
+	void releasePayload() override
+	{
+		m_cfg.reset();
+	}
+
+	QStringList objectIds() const override
+	{
+		return QStringList() << m_id;
+	}
+
 private:
 	//! Configuration.
-	Config m_cfg;
+	QSharedPointer< const Config > m_cfg;
 	//! Form.
 	Page * m_form;
 	//! Id.
@@ -142,6 +256,8 @@ private:
 template<>
 class UndoCreate< FormText, Cfg::Text > final
 	:	public QUndoCommand
+	,	public UndoPayload
+	,	public UndoObjects
 {
 public:
 	UndoCreate( Page * f, const QString & id )
@@ -204,6 +320,28 @@ public:
 		}
 	}
 
+	qint64 payloadSize() const override
+	{
+		return undoPayloadSize( m_cfg ) +
+			( m_doc ? m_doc->characterCount() * qint64( sizeof( QChar ) ) : 0 );
+	}
+
+	void releasePayload() override
+	{
+		m_cfg = Cfg::Text();
+
+		if( m_doc )
+		{
+			m_doc->deleteLater();
+			m_doc = nullptr;
+		}
+	}
+
+	QStringList objectIds() const override
+	{
+		return QStringList() << m_id;
+	}
+
 private:
 	//! Configuration.
 	Cfg::Text m_cfg;
@@ -225,6 +363,7 @@ private:
 //! Undo move.
 class UndoMove final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	UndoMove( Page * form, const QString & id, const QPointF & delta )
@@ -233,7 +372,26 @@ public:
 		,	m_delta( delta )
 		,	m_form( form )
 		,	m_undone( false )
+		,	m_time( undoTimeStamp() )
+	{
+	}
+
+	int id() const override
 	{
+		return UndoMoveId;
+	}
+
+	bool mergeWith( const QUndoCommand * other ) override
+	{
+		const auto * c = static_cast< const UndoMove* > ( other );
+
+		if( c->m_id != m_id || !isUndoMergeable( m_time, c->m_time ) )
+			return false;
+
+		m_delta += c->m_delta;
+		m_time = c->m_time;
+
+		return true;
 	}
 
 	void undo() override
@@ -261,6 +419,11 @@ public:
 		}
 	}
 
+	QStringList objectIds() const override
+	{
+		return QStringList() << m_id;
+	}
+
 private:
 	//! Id.
 	QString m_id;
@@ -270,6 +433,8 @@ private:
 	Page * m_form;
 	//! Undone?
 	bool m_undone;
+	//! Time of the last change.
+	qint64 m_time;
 }; // class UndoMove
 
 
@@ -280,6 +445,7 @@ private:
 //! Undo resize.
 class UndoResize final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	UndoResize( Page * form, const QString & id, const QRectF & oldR,
@@ -290,7 +456,26 @@ public:
 		,	m_oldRect( oldR )
 		,	m_newRect( newR )
 		,	m_undone( false )
+		,	m_time( undoTimeStamp() )
+	{
+	}
+
+	int id() const override
 	{
+		return UndoResizeId;
+	}
+
+	bool mergeWith( const QUndoCommand * other ) override
+	{
+		const auto * c = static_cast< const UndoResize* > ( other );
+
+		if( c->m_id != m_id || !isUndoMergeable( m_time, c->m_time ) )
+			return false;
+
+		m_newRect = c->m_newRect;
+		m_time = c->m_time;
+
+		return true;
 	}
 
 	void undo() override
@@ -318,6 +503,11 @@ public:
 		}
 	}
 
+	QStringList objectIds() const override
+	{
+		return QStringList() << m_id;
+	}
+
 private:
 	//! Form.
 	Page * m_form;
@@ -329,6 +519,8 @@ private:
 	QRectF m_newRect;
 	//! Undone?
 	bool m_undone;
+	//! Time of the last change.
+	qint64 m_time;
 }; // class UndoResize
 
 
@@ -340,11 +532,13 @@ private:
 template< class Elem, class Config >
 class UndoDelete final
 	:	public QUndoCommand
+	,	public UndoPayload
+	,	public UndoObjects
 {
 public:
 	UndoDelete( Page * form, const Config & c )
 		:	QUndoCommand( QObject::tr( "Delete" ) )
-		,	m_cfg( c )
+		,	m_cfg( new Config( c ) )
 		,	m_form( form )
 		,	m_undone( false )
 	{
@@ -355,9 +549,9 @@ public:
 		m_undone = true;
 
 		Elem * elem = dynamic_cast< Elem* > (
-			m_form->createElement< Elem > ( m_cfg.objectId() ) );
+			m_form->createElement< Elem > ( m_cfg->objectId() ) );
 
-		elem->setCfg( m_cfg );
+		elem->setCfg( *m_cfg );
 
 		TopGui::instance()->projectWindow()->switchToSelectMode();
 	}
@@ -366,7 +560,7 @@ public:
 	{
 		if( m_undone )
 		{
-			QGraphicsItem * elem = m_form->findItem( m_cfg.objectId() );
+			QGraphicsItem * elem = m_form->findItem( m_cfg->objectId() );
 
 			m_form->deleteItems( QList< QGraphicsItem* > () << elem, false );
 
@@ -392,9 +586,24 @@ public:
 		}
 	}
 
+	qint64 payloadSize() const override
+	{
+		return ( m_cfg ? undoPayloadSize( *m_cfg ) : 0 );
+	}
+
+	void releasePayload() override
+	{
+		m_cfg.reset();
+	}
+
+	QStringList objectIds() const override
+	{
+		return ( m_cfg ? QStringList() << m_cfg->objectId() : QStringList() );
+	}
+
 private:
 	//! Configuration.
-	Config m_cfg;
+	QSharedPointer< const Config > m_cfg;
 	//! Form.
 	Page * m_form;
 	//! Undone?
@@ -410,6 +619,8 @@ private:
 template<>
 class UndoDelete< FormText, Cfg::Text > final
 	:	public QUndoCommand
+	,	public UndoPayload
+	,	public UndoObjects
 {
 public:
 	UndoDelete( Page * form, const Cfg::Text & c )
@@ -483,6 +694,29 @@ public:
 		}
 	}
 
+	qint64 payloadSize() const override
+	{
+		return undoPayloadSize( m_cfg ) +
+			( m_doc ? m_doc->characterCount() * qint64( sizeof( QChar ) ) : 0 );
+	}
+
+	void releasePayload() override
+	{
+		m_cfg = Cfg::Text();
+
+		if( m_doc )
+		{
+			m_doc->deleteLater();
+			m_doc = nullptr;
+		}
+	}
+
+	QStringList objectIds() const override
+	{
+		return ( m_cfg.objectId().isEmpty() ? QStringList() :
+			QStringList() << m_cfg.objectId() );
+	}
+
 private:
 	//! Configuration.
 	Cfg::Text m_cfg;
@@ -502,6 +736,7 @@ private:
 //! Undo group.
 class UndoGroup final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	UndoGroup( Page * form, const QString & id );
@@ -510,6 +745,8 @@ public:
 
 	void redo() override;
 
+	QStringList objectIds() const override;
+
 private:
 	//! Form.
 	Page * m_form;
@@ -529,6 +766,7 @@ private:
 //! Undo ungroup.
 class UndoUngroup final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	UndoUngroup( const QStringList & items,
@@ -538,6 +776,8 @@ public:
 
 	void redo() override;
 
+	QStringList objectIds() const override;
+
 private:
 	//! Items.
 	QStringList m_items;
@@ -557,6 +797,7 @@ private:
 //! Undo adding line to polyline.
 class UndoAddLineToPoly final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	UndoAddLineToPoly( Page * form,
@@ -566,6 +807,8 @@ public:
 
 	void redo() override;
 
+	QStringList objectIds() const override;
+
 private:
 	//! Line.
 	QLineF m_line;
@@ -585,6 +828,7 @@ private:
 //! Undo change line.
 class UndoChangeLine final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	UndoChangeLine( Page * form, const QString & id, const QLineF & oldLine,
@@ -594,6 +838,8 @@ public:
 
 	void redo() override;
 
+	QStringList objectIds() const override;
+
 private:
 	//! Form.
 	Page * m_form;
@@ -615,6 +861,7 @@ private:
 //! Undo changing of pen.
 class UndoChangePen final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	UndoChangePen( Page * form, const QString & id, const QPen & oldPen,
@@ -624,6 +871,12 @@ public:
 
 	void redo() override;
 
+	int id() const override;
+
+	bool mergeWith( const QUndoCommand * other ) override;
+
+	QStringList objectIds() const override;
+
 private:
 	//! Form.
 	Page * m_form;
@@ -635,6 +888,8 @@ private:
 	QPen m_newPen;
 	//! Undone?
 	bool m_undone;
+	//! Time of the last change.
+	qint64 m_time;
 }; // class UndoChangePen
 
 
@@ -645,6 +900,7 @@ private:
 //! Undo changing of brush.
 class UndoChangeBrush final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	UndoChangeBrush( Page * form, const QString & id, const QBrush & oldBrush,
@@ -654,6 +910,12 @@ public:
 
 	void redo() override;
 
+	int id() const override;
+
+	bool mergeWith( const QUndoCommand * other ) override;
+
+	QStringList objectIds() const override;
+
 private:
 	//! Form.
 	Page * m_form;
@@ -665,6 +927,8 @@ private:
 	QBrush m_newBrush;
 	//! Undone?
 	bool m_undone;
+	//! Time of the last change.
+	qint64 m_time;
 }; // class UndoChangeBrush
 
 
@@ -675,6 +939,7 @@ private:
 //! Undo text changing on the form.
 class UndoChangeTextOnForm final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	UndoChangeTextOnForm( Page * form, const QString & id );
@@ -683,6 +948,8 @@ public:
 
 	void redo() override;
 
+	QStringList objectIds() const override;
+
 private:
 	//! Form.
 	Page * m_form;
@@ -700,18 +967,21 @@ private:
 //! Undo changing text with options.
 class UndoChangeTextWithOpts final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	UndoChangeTextWithOpts( Page * form, const QString & id,
-		const Cfg::TextStyle & oldOpts, const Cfg::TextStyle & newOpts );
+		const Cfg::TextRun & oldOpts, const Cfg::TextRun & newOpts );
 
 	void undo() override;
 
 	void redo() override;
 
+	QStringList objectIds() const override;
+
 private:
 	//! Set text options.
-	void setTextOpts( const Cfg::TextStyle & opts );
+	void setTextOpts( const Cfg::TextRun & opts );
 
 private:
 	//! Form.
@@ -719,9 +989,9 @@ private:
 	//! Id.
 	QString m_id;
 	//! Old options.
-	Cfg::TextStyle m_oldOpts;
+	Cfg::TextRun m_oldOpts;
 	//! New options.
-	Cfg::TextStyle m_newOpts;
+	Cfg::TextRun m_newOpts;
 	//! Undone?
 	bool m_undone;
 }; // class UndoChangeTextWithOpts
@@ -734,6 +1004,7 @@ private:
 //! Undo changing of check state.
 class UndoChangeCheckState final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	UndoChangeCheckState( Page * form, const QString & id );
@@ -742,6 +1013,8 @@ public:
 
 	void redo() override;
 
+	QStringList objectIds() const override;
+
 private:
 	FormCheckBox * find() const;
 
@@ -764,6 +1037,7 @@ private:
 //! Undo duplicate.
 class UndoDuplicate final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	UndoDuplicate( Page * form, const QStringList & origIds,
@@ -773,6 +1047,8 @@ public:
 
 	void redo() override;
 
+	QStringList objectIds() const override;
+
 private:
 	//! Form.
 	Page * m_form;
@@ -794,6 +1070,7 @@ private:
 //! Undo changing of Z index.
 class UndoChangeZ final
 	:	public QUndoCommand
+	,	public UndoObjects
 {
 public:
 	using ZAndIds = QVector< QPair< QString, qreal > >;
@@ -805,6 +1082,12 @@ public:
 
 	void redo() override;
 
+	int id() const override;
+
+	bool mergeWith( const QUndoCommand * other ) override;
+
+	QStringList objectIds() const override;
+
 private:
 	//! Form.
 	Page * m_form;
@@ -814,8 +1097,93 @@ private:
 	ZAndIds m_new;
 	//! Undone?
 	bool m_undone;
+	//! Time of the last change.
+	qint64 m_time;
 }; // class UndoChangeZ
 
+
+//
+// UndoMoveMany
+//
+
+//! Undo move of several objects at once.
+class UndoMoveMany final
+	:	public QUndoCommand
+	,	public UndoObjects
+{
+public:
+	using DeltaAndIds = QVector< QPair< QString, QPointF > >;
+
+	UndoMoveMany( Page * form, const DeltaAndIds & deltas,
+		const QString & text );
+
+	void undo() override;
+
+	void redo() override;
+
+	int id() const override;
+
+	bool mergeWith( const QUndoCommand * other ) override;
+
+	QStringList objectIds() const override;
+
+private:
+	//! Move objects.
+	void move( qreal sign );
+
+private:
+	//! Form.
+	Page * m_form;
+	//! Deltas.
+	DeltaAndIds m_deltas;
+	//! Undone?
+	bool m_undone;
+	//! Time of the last change.
+	qint64 m_time;
+}; // class UndoMoveMany
+
+
+//
+// UndoChangePoints
+//
+
+//! Undo change of vertices of polylines.
+class UndoChangePoints final
+	:	public QUndoCommand
+	,	public UndoPayload
+	,	public UndoObjects
+{
+public:
+	using PointsAndIds = QVector< QPair< QString, QVector< QPointF > > >;
+
+	UndoChangePoints( Page * form, const PointsAndIds & origPoints,
+		const PointsAndIds & newPoints, const QString & text );
+
+	void undo() override;
+
+	void redo() override;
+
+	qint64 payloadSize() const override;
+
+	void releasePayload() override;
+
+	QStringList objectIds() const override;
+
+private:
+	//! Set vertices of polylines.
+	void setPoints( const PointsAndIds & points );
+
+private:
+	//! Form.
+	Page * m_form;
+	//! Original vertices.
+	PointsAndIds m_orig;
+	//! New vertices.
+	PointsAndIds m_new;
+	//! Undone?
+	bool m_undone;
+}; // class UndoChangePoints
+
 } /* namespace Core */
 
 } /* namespace Prototyper */
@@ -77,11 +77,15 @@ FormVSliderPrivate::init()
 		false );
 
 	q->setObjectBrush( Qt::transparent, false );
+
+	updateRenderCache( q, false );
 }
 
 void
 FormVSliderPrivate::setRect( const QRectF & rect )
 {
+	q->prepareGeometryChange();
+
 	m_rect = rect;
 
 	q->setPos( m_rect.topLeft() );
@@ -114,12 +118,11 @@ FormVSlider::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	Q_UNUSED( widget )
 	Q_UNUSED( option )
 
-	draw( painter, d->m_rect, objectPen() );
-
-	if( isSelected() && !group() )
-		d->m_proxy->show();
+	if( isLowDetail( levelOfDetail( painter ),
+		qMin( d->m_rect.width(), d->m_rect.height() ) ) )
+			drawLowDetail( painter, d->m_rect, objectPen(), QBrush( objectPen().color() ) );
 	else
-		d->m_proxy->hide();
+		draw( painter, d->m_rect, objectPen() );
 }
 
 void
@@ -269,6 +272,19 @@ FormVSlider::moveResizable( const QPointF & delta )
 	moveBy( delta.x(), delta.y() );
 }
 
+QVariant
+FormVSlider::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemSelectedHasChanged )
+	{
+		updateRenderCache( this, value.toBool() );
+
+		d->m_proxy->setVisible( value.toBool() && !group() );
+	}
+
+	return QGraphicsItem::itemChange( change, value );
+}
+
 QSizeF
 FormVSlider::defaultSize() const
 {
@@ -276,9 +292,10 @@ FormVSlider::defaultSize() const
 }
 
 FormObject *
-FormVSlider::clone() const
+FormVSlider::clone( QGraphicsItem * parent ) const
 {
-	auto * o = new FormVSlider( rectangle(), page(), parentItem() );
+	auto * o = new FormVSlider( rectangle(), page(),
+		( parent ? parent : parentItem() ) );
 
 	o->setCfg( cfg() );
 
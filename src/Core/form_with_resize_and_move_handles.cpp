@@ -27,6 +27,9 @@
 #include "form_with_resize_and_move_handles.hpp"
 #include "constants.hpp"
 
+// Qt include.
+#include <QGraphicsScene>
+
 
 namespace Prototyper {
 
@@ -38,53 +41,106 @@ namespace Core {
 
 WithResizeAndMoveHandles::WithResizeAndMoveHandles( FormWithHandle * object,
 	QGraphicsItem * parent, Page * form )
-	:	m_topLeft( new FormResizeHandle( c_halfResizeHandleSize,
-			QPointF( c_halfResizeHandleSize * c_halfDivider,
-				c_halfResizeHandleSize * c_halfDivider),
-			-45.0,
-			object, parent, form, Qt::SizeFDiagCursor ) )
-	,	m_top( new FormResizeHandle( c_halfResizeHandleSize,
-			QPointF( c_halfResizeHandleSize,
-				c_halfResizeHandleSize * c_halfDivider),
-			0.0,
-			object, parent, form, Qt::SizeVerCursor ) )
-	,	m_topRight( new FormResizeHandle( c_halfResizeHandleSize,
-			QPointF( 0.0, c_halfResizeHandleSize * c_halfDivider ),
-			45.0,
-			object, parent, form, Qt::SizeBDiagCursor ) )
-	,	m_left( new FormResizeHandle( c_halfResizeHandleSize,
-			QPointF( c_halfResizeHandleSize * c_halfDivider,
-				c_halfResizeHandleSize ),
-			-90.0,
-			object, parent, form, Qt::SizeHorCursor ) )
-	,	m_bottomLeft( new FormResizeHandle( c_halfResizeHandleSize,
-			QPointF( c_halfResizeHandleSize * c_halfDivider, 0.0 ),
-			45.0,
-			object, parent, form, Qt::SizeBDiagCursor ) )
-	,	m_bottom( new FormResizeHandle( c_halfResizeHandleSize,
-			QPointF( c_halfResizeHandleSize, 0.0 ), 0.0,
-			object, parent, form, Qt::SizeVerCursor ) )
-	,	m_bottomRight( new FormResizeHandle( c_halfResizeHandleSize,
-			QPointF( 0.0, 0.0 ),
-			-45.0,
-			object, parent, form, Qt::SizeFDiagCursor ) )
-	,	m_right( new FormResizeHandle( c_halfResizeHandleSize,
-			QPointF( 0.0, c_halfResizeHandleSize ),
-			90,
-			object, parent, form, Qt::SizeHorCursor ) )
-	,	m_move( new FormMoveHandle( c_halfHandleSize,
-			QPointF( c_halfHandleSize, c_halfHandleSize ),
-			object, parent, form, Qt::SizeAllCursor ) )
-	,	q( parent )
+	:	q( parent )
 	,	m_min( c_minResizableSize, c_minResizableSize )
+	,	m_object( object )
+	,	m_form( form )
+	,	m_delta( 0.0 )
 {
 }
 
 WithResizeAndMoveHandles::~WithResizeAndMoveHandles() = default;
 
+void
+WithResizeAndMoveHandles::create()
+{
+	m_topLeft.reset( new FormResizeHandle( c_halfResizeHandleSize,
+		QPointF( c_halfResizeHandleSize * c_halfDivider,
+			c_halfResizeHandleSize * c_halfDivider),
+		-45.0,
+		m_object, q, m_form, Qt::SizeFDiagCursor ) );
+	m_top.reset( new FormResizeHandle( c_halfResizeHandleSize,
+		QPointF( c_halfResizeHandleSize,
+			c_halfResizeHandleSize * c_halfDivider),
+		0.0,
+		m_object, q, m_form, Qt::SizeVerCursor ) );
+	m_topRight.reset( new FormResizeHandle( c_halfResizeHandleSize,
+		QPointF( 0.0, c_halfResizeHandleSize * c_halfDivider ),
+		45.0,
+		m_object, q, m_form, Qt::SizeBDiagCursor ) );
+	m_left.reset( new FormResizeHandle( c_halfResizeHandleSize,
+		QPointF( c_halfResizeHandleSize * c_halfDivider,
+			c_halfResizeHandleSize ),
+		-90.0,
+		m_object, q, m_form, Qt::SizeHorCursor ) );
+	m_bottomLeft.reset( new FormResizeHandle( c_halfResizeHandleSize,
+		QPointF( c_halfResizeHandleSize * c_halfDivider, 0.0 ),
+		45.0,
+		m_object, q, m_form, Qt::SizeBDiagCursor ) );
+	m_bottom.reset( new FormResizeHandle( c_halfResizeHandleSize,
+		QPointF( c_halfResizeHandleSize, 0.0 ), 0.0,
+		m_object, q, m_form, Qt::SizeVerCursor ) );
+	m_bottomRight.reset( new FormResizeHandle( c_halfResizeHandleSize,
+		QPointF( 0.0, 0.0 ),
+		-45.0,
+		m_object, q, m_form, Qt::SizeFDiagCursor ) );
+	m_right.reset( new FormResizeHandle( c_halfResizeHandleSize,
+		QPointF( 0.0, c_halfResizeHandleSize ),
+		90,
+		m_object, q, m_form, Qt::SizeHorCursor ) );
+	m_move.reset( new FormMoveHandle( c_halfHandleSize,
+		QPointF( c_halfHandleSize, c_halfHandleSize ),
+		m_object, q, m_form, Qt::SizeAllCursor ) );
+
+	if( !qFuzzyIsNull( m_delta ) )
+		setDeltaToZero( m_delta );
+
+	place( m_rect );
+}
+
+void
+WithResizeAndMoveHandles::release()
+{
+	m_topLeft.reset();
+	m_top.reset();
+	m_topRight.reset();
+	m_left.reset();
+	m_bottomLeft.reset();
+	m_bottom.reset();
+	m_bottomRight.reset();
+	m_right.reset();
+	m_move.reset();
+}
+
+bool
+WithResizeAndMoveHandles::isCreated() const
+{
+	return !m_move.isNull();
+}
+
+bool
+WithResizeAndMoveHandles::isInUse() const
+{
+	if( !isCreated() || !m_move->scene() )
+		return false;
+
+	const QGraphicsItem * grabber = m_move->scene()->mouseGrabberItem();
+
+	return ( grabber && ( grabber == m_topLeft.data() ||
+		grabber == m_top.data() || grabber == m_topRight.data() ||
+		grabber == m_left.data() || grabber == m_bottomLeft.data() ||
+		grabber == m_bottom.data() || grabber == m_bottomRight.data() ||
+		grabber == m_right.data() || grabber == m_move.data() ) );
+}
+
 void
 WithResizeAndMoveHandles::place( const QRectF & r )
 {
+	m_rect = r;
+
+	if( !isCreated() )
+		return;
+
 	m_topLeft->setPos( r.x(), r.y() );
 	m_top->setPos( r.x() + r.width() / c_halfDivider -
 		m_top->halfOfSize(), r.y() );
@@ -117,6 +173,9 @@ WithResizeAndMoveHandles::place( const QRectF & r )
 void
 WithResizeAndMoveHandles::show()
 {
+	if( !isCreated() )
+		create();
+
 	m_topLeft->show();
 	m_top->show();
 	m_topRight->show();
@@ -131,6 +190,16 @@ WithResizeAndMoveHandles::show()
 void
 WithResizeAndMoveHandles::hide()
 {
+	if( !isCreated() )
+		return;
+
+	if( !isInUse() )
+	{
+		release();
+
+		return;
+	}
+
 	m_topLeft->hide();
 	m_top->hide();
 	m_topRight->hide();
@@ -158,6 +227,11 @@ WithResizeAndMoveHandles::setMinSize( const QSizeF & min )
 void
 WithResizeAndMoveHandles::setDeltaToZero( qreal delta )
 {
+	m_delta = delta;
+
+	if( !isCreated() )
+		return;
+
 	m_topLeft->setDeltaToZero( QPointF( delta, delta ) );
 	m_top->setDeltaToZero( QPointF( 0.0, delta ) );
 	m_topRight->setDeltaToZero( QPointF( -delta, delta ) );
@@ -27,6 +27,7 @@
 #include <QtGlobal>
 #include <QScopedPointer>
 #include <QSizeF>
+#include <QRectF>
 
 QT_BEGIN_NAMESPACE
 class QGraphicsItem;
@@ -48,7 +49,9 @@ class Page;
 // WithResizeAndMoveHandles
 //
 
-//! Storage of resize and move handles.
+//! Storage of resize and move handles. Handles are created when they are
+//! shown and released when they are hidden, so not selected objects
+//! don't have handle items at all.
 class WithResizeAndMoveHandles final {
 public:
 	WithResizeAndMoveHandles( FormWithHandle * object,
@@ -61,6 +64,10 @@ public:
 	void show();
 	//! Hide handles.
 	void hide();
+	//! \return Are handles created?
+	bool isCreated() const;
+	//! \return Is one of the handles grabbing mouse?
+	bool isInUse() const;
 	//! Check constraint.
 	bool checkConstraint( const QSizeF & s );
 	//! Set min size.
@@ -90,6 +97,21 @@ public:
 	QGraphicsItem * q;
 	//! Min size.
 	QSizeF m_min;
+
+private:
+	//! Create handles.
+	void create();
+	//! Release handles.
+	void release();
+
+	//! Object.
+	FormWithHandle * m_object;
+	//! Form.
+	Page * m_form;
+	//! Rect of the handles.
+	QRectF m_rect;
+	//! Additional space to zero point.
+	qreal m_delta;
 }; // class WithResizeAndMoveHandles
 
 } /* namespace Core */
@@ -46,7 +46,7 @@ class HtmlExporterPrivate
 	:	public ExporterPrivate
 {
 public:
-	HtmlExporterPrivate( const Cfg::Project & cfg, HtmlExporter * parent )
+	HtmlExporterPrivate( const ProjectSnapshot & cfg, HtmlExporter * parent )
 		:	ExporterPrivate( cfg, parent )
 	{
 	}
@@ -55,45 +55,41 @@ public:
 	void printDocument( QTextStream & stream );
 }; // class HtmlExporterPrivate
 
-static inline QString printStyle( const Cfg::TextStyle & style )
+static inline QString printStyle( const Cfg::TextRun & style )
 {
 	return QStringLiteral( "style=\"font-size: " ) +
-		QString::number( qRound( style.fontSize() ) )
+		QString::number( qRound( style.m_fontSize ) )
 		+ QStringLiteral( "pt;\"" );
 }
 
 static inline void printText( QTextStream & stream,
-	const std::vector< Cfg::TextStyle > & text )
+	const std::vector< Cfg::TextRun > & text )
 {
-	foreach( const Cfg::TextStyle & t, text )
+	for( const auto & t : text )
 	{
+		const Cfg::TextStyleFlags flags = t.m_style;
+
 		stream << QStringLiteral( "<span " )
 			<< printStyle( t )
 			<< QStringLiteral( ">" )
-			<< ( std::find( t.style().cbegin(), t.style().cend(),
-					Cfg::c_boldStyle ) != t.style().cend() ?
-						QStringLiteral( "<b>" ) : QString() )
-			<< ( std::find( t.style().cbegin(), t.style().cend(),
-					Cfg::c_italicStyle ) != t.style().cend() ?
-						QStringLiteral( "<i>" ) : QString() )
-			<< ( std::find( t.style().cbegin(), t.style().cend(),
-					Cfg::c_underlineStyle ) != t.style().cend() ?
-						QStringLiteral( "<ins>" ) : QString() );
-
-		QStringList strings = t.text().split( QLatin1Char( '\n' ) );
+			<< ( flags.testFlag( Cfg::BoldStyle ) ?
+					QStringLiteral( "<b>" ) : QString() )
+			<< ( flags.testFlag( Cfg::ItalicStyle ) ?
+					QStringLiteral( "<i>" ) : QString() )
+			<< ( flags.testFlag( Cfg::UnderlineStyle ) ?
+					QStringLiteral( "<ins>" ) : QString() );
+
+		QStringList strings = t.m_text.split( QLatin1Char( '\n' ) );
 
 		foreach( const QString & str, strings )
 			stream << str << QStringLiteral( "<br>" ) << Qt::endl;
 
-		stream << ( std::find( t.style().cbegin(), t.style().cend(),
-					Cfg::c_underlineStyle ) != t.style().cend()  ?
-						QStringLiteral( "</ins>" ) : QString() )
-			<< ( std::find( t.style().cbegin(), t.style().cend(),
-					Cfg::c_italicStyle ) != t.style().cend() ?
-						QStringLiteral( "</i>" ) : QString() )
-			<< ( std::find( t.style().cbegin(), t.style().cend(),
-					Cfg::c_boldStyle ) != t.style().cend() ?
-						QStringLiteral( "</b>" ) : QString() )
+		stream << ( flags.testFlag( Cfg::UnderlineStyle ) ?
+					QStringLiteral( "</ins>" ) : QString() )
+			<< ( flags.testFlag( Cfg::ItalicStyle ) ?
+					QStringLiteral( "</i>" ) : QString() )
+			<< ( flags.testFlag( Cfg::BoldStyle ) ?
+					QStringLiteral( "</b>" ) : QString() )
 			<< QStringLiteral( "</span>" )
 			<< Qt::endl;
 	}
@@ -106,17 +102,17 @@ HtmlExporterPrivate::printDocument( QTextStream & stream )
 		<< Qt::endl << QStringLiteral( "<body>" ) << Qt::endl
 		<< QStringLiteral( "<div style=\"width: 800px; margin: auto;\">" ) ;
 
-	printText( stream, m_cfg.description().text() );
+	printText( stream, Cfg::textRuns( m_cfg.description().text() ) );
 
 	stream << QStringLiteral( "<br><br>" ) << Qt::endl;
 
 	foreach( const Cfg::Page & form, m_cfg.page() )
 	{
-		std::vector< Cfg::TextStyle > headList;
-		Cfg::TextStyle head;
-		head.style().push_back( Cfg::c_boldStyle );
-		head.fontSize() = c_headerFontSize;
-		head.text() = form.tabName();
+		std::vector< Cfg::TextRun > headList;
+		Cfg::TextRun head;
+		head.m_style = Cfg::BoldStyle;
+		head.m_fontSize = c_headerFontSize;
+		head.m_text = form.tabName();
 		headList.push_back( head );
 
 		stream << QStringLiteral( "<a name=\"" )
@@ -153,7 +149,7 @@ HtmlExporterPrivate::printDocument( QTextStream & stream )
 // HtmlExporter
 //
 
-HtmlExporter::HtmlExporter( const Cfg::Project & project )
+HtmlExporter::HtmlExporter( const ProjectSnapshot & project )
 	:	Exporter( QScopedPointer< ExporterPrivate >
 			( new HtmlExporterPrivate( project, this ) ) )
 {
@@ -42,7 +42,7 @@ class HtmlExporter final
 	:	public Exporter
 {
 public:
-	explicit HtmlExporter( const Cfg::Project & project );
+	explicit HtmlExporter( const ProjectSnapshot & project );
 	~HtmlExporter() override;
 
 	//! Export documentation.
@@ -35,6 +35,8 @@
 #include "form_undo_commands.hpp"
 #include "constants.hpp"
 #include "form_grid_snap.hpp"
+#include "form_object_snap.hpp"
+#include "z_order.hpp"
 #include "form_comment.hpp"
 
 // Qt include.
@@ -56,17 +58,63 @@
 #include <QUndoStack>
 #include <QUndoGroup>
 #include <QMap>
+#include <QSet>
+#include <QUrl>
+#include <QImageReader>
+#include <QFutureWatcher>
+#include <QTimer>
+#include <QtConcurrentRun>
 
 // C++ include.
 #include <algorithm>
 #include <type_traits>
-#include <functional>
 
 
 namespace Prototyper {
 
 namespace Core {
 
+namespace /* anonymous */ {
+
+//! Apply render cache setting to the items and children of groups.
+void applyRenderCache( const QList< QGraphicsItem* > & items )
+{
+	for( const auto & item : items )
+	{
+		const auto * obj = dynamic_cast< FormObject* > ( item );
+
+		if( !obj )
+			continue;
+
+		switch( obj->objectType() )
+		{
+			case FormObject::TextType :
+				updateRenderCache( item, item->hasFocus() );
+				break;
+
+			case FormObject::GroupType :
+				applyRenderCache( item->childItems() );
+				break;
+
+			case FormObject::ButtonType :
+			case FormObject::ComboBoxType :
+			case FormObject::RadioButtonType :
+			case FormObject::CheckBoxType :
+			case FormObject::HSliderType :
+			case FormObject::VSliderType :
+			case FormObject::SpinBoxType :
+				updateRenderCache( item, item->isSelected() );
+				break;
+
+			default :
+				break;
+		}
+	}
+}
+
+} /* namespace anonymous */
+
+
 //
 // FormPrivate
 //
@@ -83,69 +131,156 @@ PagePrivate::init()
 	m_snap = new GridSnap( q );
 	m_snap->setGridStep( m_cfg.gridStep() );
 
+	m_objectSnap.reset( new ObjectSnap( q ) );
+	m_snap->setObjectSnap( m_objectSnap.data() );
+
+	m_zOrder.reset( new ZOrder( q ) );
+
 	q->setAcceptHoverEvents( true );
 
 	q->setAcceptDrops( true );
 
 	m_undoStack = new QUndoStack(
 		TopGui::instance()->projectWindow()->projectWidget()->undoGroup() );
-}
+	m_undoStack->setUndoLimit( c_undoLimit );
 
-bool
-PagePrivate::isCommentUnderMouse() const
-{
-	for( const auto & c : qAsConst( m_comments ) )
-		if( c->isUnderMouse() )
-			return true;
+	Page::connect( m_undoStack, &QUndoStack::cleanChanged, q,
+		[this] () { updateModified(); } );
+	Page::connect( m_undoStack, &QUndoStack::indexChanged, q,
+		[this] ()
+		{
+			if( m_isDroppingCommands )
+				return;
 
-	return false;
+			m_objectSnap->invalidate();
+
+			if( m_undoStack->index() == m_undoStack->count() )
+				trimUndoHistory();
+
+			// Other receivers see this change before obsolete commands go.
+			if( m_undoStack->index() > 0 && m_undoStack->command(
+				m_undoStack->index() - 1 )->isObsolete() )
+					QTimer::singleShot( 0, q, [this] () { dropObsoleteCommands(); } );
+
+			if( !m_loadedImages.isEmpty() )
+				pruneLoadedImages();
+		} );
 }
 
-qreal
-PagePrivate::currentZValue() const
+void
+PagePrivate::updateModified()
 {
-	qreal z = 0.0;
+	const bool modified = !m_undoStack->isClean() || m_isCommentChanged;
 
-	currentZValue( q->childItems(), z, true );
+	if( modified != m_isModified )
+	{
+		m_isModified = modified;
 
-	return z;
+		emit q->modifiedChanged( m_isModified );
+	}
 }
 
-namespace /* anonymous */ {
+void
+PagePrivate::connectComment( PageComment * c )
+{
+	Page::connect( c, &PageComment::changed, q, &Page::changed );
+	Page::connect( c, &PageComment::changed, q,
+		[this, c] ()
+		{
+			if( c->isChanged() )
+			{
+				m_isCommentChanged = true;
+
+				updateModified();
+			}
+		} );
+}
 
-//! Find Z border element with comparator.
-template< typename U >
 void
-findZBorder( const QList< QGraphicsItem* > & items,
-	qreal & z, bool initZ, U u )
+PagePrivate::importImage( const QPointF & pos, const QString & fileName,
+	const QImage & image )
 {
-	for( const auto & item : qAsConst( items ) )
-	{
-		const QList< QGraphicsItem* > children = item->childItems();
+	auto * item = new FormImage( q, q );
 
-		if( !children.isEmpty() )
-			findZBorder( children, z, false, u );
+	m_zOrder->setZValue( item, currentZValue() + 1.0 );
 
-		auto * obj = dynamic_cast< FormObject* > ( item );
+	const QString id = this->id();
 
-		if( obj && initZ )
-		{
-			z = item->zValue();
-			initZ = false;
-		}
+	item->setObjectId( id );
+
+	m_ids.append( id );
+
+	m_loadingImages.insert( id, false );
 
-		if( obj && u( item->zValue(), z ) )
-			z = item->zValue();
+	if( PageAction::instance()->mode() == PageAction::Select )
+	{
+		item->setFlag( QGraphicsItem::ItemIsSelectable, true );
+
+		item->setSelected( true );
 	}
+
+	item->setPos( pos );
+
+	item->setPlaceholder();
+
+	// Command is pushed when the placeholder is in place, so undo history
+	// records it there.
+	m_undoStack->push( new UndoCreate< FormImage, Cfg::Image > ( q, id ) );
+
+	using Result = QPair< QImage, QImage >;
+
+	auto * watcher = new QFutureWatcher< Result > ( q );
+
+	// Image is looked up by ID, it may be deleted while it's loading.
+	Page::connect( watcher, &QFutureWatcher< Result >::finished, q,
+		[this, watcher, id] () {
+			auto * img = dynamic_cast< FormImage* > ( q->findItem( id ) );
+
+			// Undo commands keep the placeholder, give them the image.
+			if( m_loadingImages.take( id ) && !watcher->result().first.isNull() )
+				m_loadedImages.insert( id, watcher->result() );
+
+			if( img && !watcher->result().first.isNull() )
+			{
+				img->setImage( watcher->result().first,
+					watcher->result().second );
+				img->updatePropertiesValues();
+
+				m_objectSnap->invalidate();
+
+				q->update();
+
+				emit q->changed();
+			}
+
+			watcher->deleteLater();
+		} );
+
+	const int maxSize = PageAction::instance()->maxImageSize();
+
+	watcher->setFuture( QtConcurrent::run( [fileName, image, maxSize] () {
+		const QImage img = ( image.isNull() ?
+			FormImage::readImage( fileName, maxSize ) :
+			FormImage::fitImage( image, maxSize ) );
+
+		return qMakePair( img, FormImage::makePreview( img ) );
+	} ) );
 }
 
-} /* namespace anonymous */
+bool
+PagePrivate::isCommentUnderMouse() const
+{
+	for( const auto & c : qAsConst( m_comments ) )
+		if( c->isUnderMouse() )
+			return true;
 
-void
-PagePrivate::currentZValue( const QList< QGraphicsItem* > & items,
-	qreal & z, bool initZ ) const
+	return false;
+}
+
+qreal
+PagePrivate::currentZValue() const
 {
-	findZBorder( items, z, initZ, std::greater< qreal > () );
+	return m_zOrder->top();
 }
 
 QPointF
@@ -224,6 +359,8 @@ PagePrivate::ungroup( QGraphicsItem * group, bool pushUndoCommand )
 		{
 			tmp->removeFromGroup( item );
 
+			m_zOrder->update( item );
+
 			auto * o = dynamic_cast< FormObject* > ( item );
 
 			if( o )
@@ -267,108 +404,162 @@ PagePrivate::updateFromCfg()
 {
 	clear();
 
-	QApplication::processEvents();
+	setCommonCfg( m_cfg );
+
+	q->setObjectId( m_cfg.tabName() );
+
+	m_ids.append( m_cfg.tabName() );
+
+	createObjects( m_cfg );
+
+	m_zOrder->compact();
+
+	// Items live in the scene now, don't keep second copy of them.
+	m_cfg.line().clear();
+	m_cfg.polyline().clear();
+	m_cfg.text().clear();
+	m_cfg.image().clear();
+	m_cfg.group().clear();
+	m_cfg.rect().clear();
+	m_cfg.button().clear();
+	m_cfg.checkbox().clear();
+	m_cfg.combobox().clear();
+	m_cfg.radiobutton().clear();
+	m_cfg.hslider().clear();
+	m_cfg.vslider().clear();
+	m_cfg.spinbox().clear();
+	m_cfg.comments().clear();
 
+	q->update();
+}
+
+void
+PagePrivate::setCommonCfg( const Cfg::Page & c )
+{
 	Cfg::Size size;
-	size.set_width( MmPx::instance().fromMmX( m_cfg.size().width() ) );
-	size.set_height( MmPx::instance().fromMmY( m_cfg.size().height() ) );
+	size.set_width( MmPx::instance().fromMmX( c.size().width() ) );
+	size.set_height( MmPx::instance().fromMmY( c.size().height() ) );
 
 	q->setSize( size );
 
-	q->setGridStep( m_cfg.gridStep() );
+	q->setGridStep( c.gridStep() );
 
-	q->setObjectId( m_cfg.tabName() );
+	for( const auto & comment : qAsConst( m_comments ) )
+		delete comment;
 
-	m_ids.append( m_cfg.tabName() );
+	m_comments.clear();
+
+	for( const auto & comment : c.comments() )
+	{
+		auto * pc = new PageComment( q );
+		pc->setCfg( comment );
+		m_comments.append( pc );
+		connectComment( pc );
+	}
 
-	foreach( const Cfg::Line & c, m_cfg.line() )
-		createElem< FormLine > ( c );
+	m_objectSnap->invalidate();
+}
 
-	foreach( const Cfg::Polyline & c, m_cfg.polyline() )
-		createElem< FormPolyline > ( c );
+void
+PagePrivate::createObjects( const Cfg::Page & c )
+{
+	for( const auto & cfg : c.line() )
+		createElem< FormLine > ( cfg );
 
-	foreach( const Cfg::Text & c, m_cfg.text() )
-		createText( c );
+	for( const auto & cfg : c.polyline() )
+		createElem< FormPolyline > ( cfg );
 
-	foreach( const Cfg::Image & c, m_cfg.image() )
-		createElem< FormImage > ( c );
+	for( const auto & cfg : c.text() )
+		createText( cfg );
 
-	foreach( const Cfg::Rect & c, m_cfg.rect() )
-		createElem< FormRect > ( c );
+	for( const auto & cfg : c.image() )
+		createElem< FormImage > ( cfg );
 
-	foreach( const Cfg::Group & c, m_cfg.group() )
-		createGroup( c );
+	for( const auto & cfg : c.rect() )
+		createElem< FormRect > ( cfg );
 
-	foreach( const Cfg::Button & c, m_cfg.button() )
-		createElemWithRect< FormButton > ( c, QRectF() );
+	for( const auto & cfg : c.group() )
+		createGroup( cfg );
 
-	foreach( const Cfg::ComboBox & c, m_cfg.combobox() )
-		createElemWithRect< FormComboBox > ( c, QRectF() );
+	for( const auto & cfg : c.button() )
+		createElemWithRect< FormButton > ( cfg, QRectF() );
 
-	foreach( const Cfg::CheckBox & c, m_cfg.radiobutton() )
-		createElemWithRect< FormRadioButton > ( c, QRectF() );
+	for( const auto & cfg : c.combobox() )
+		createElemWithRect< FormComboBox > ( cfg, QRectF() );
 
-	foreach( const Cfg::CheckBox & c, m_cfg.checkbox() )
-		createElemWithRect< FormCheckBox > ( c, QRectF() );
+	for( const auto & cfg : c.radiobutton() )
+		createElemWithRect< FormRadioButton > ( cfg, QRectF() );
 
-	foreach( const Cfg::HSlider & c, m_cfg.hslider() )
-		createElemWithRect< FormHSlider > ( c, QRectF() );
+	for( const auto & cfg : c.checkbox() )
+		createElemWithRect< FormCheckBox > ( cfg, QRectF() );
 
-	foreach( const Cfg::VSlider & c, m_cfg.vslider() )
-		createElemWithRect< FormVSlider > ( c, QRectF() );
+	for( const auto & cfg : c.hslider() )
+		createElemWithRect< FormHSlider > ( cfg, QRectF() );
 
-	foreach( const Cfg::SpinBox & c, m_cfg.spinbox() )
-		createElemWithRect< FormSpinBox > ( c, QRectF() );
+	for( const auto & cfg : c.vslider() )
+		createElemWithRect< FormVSlider > ( cfg, QRectF() );
 
-	for( const auto & comment : m_cfg.comments() )
-	{
-		auto * c = new PageComment( q );
-		c->setCfg( comment );
-		m_comments.append( c );
-		Page::connect( c, &PageComment::changed, q, &Page::changed );
-	}
+	for( const auto & cfg : c.spinbox() )
+		createElemWithRect< FormSpinBox > ( cfg, QRectF() );
 
-	q->update();
+	m_objectSnap->invalidate();
 }
 
 void
 PagePrivate::clear()
 {
-	m_ids.clear();
+	// Handles and proxies of the objects are children of the page too,
+	// but they are owned and deleted by their objects.
+	QList< QGraphicsItem* > items;
 
-	QList< QGraphicsItem* > items = q->childItems();
+	for( const auto & item : q->childItems() )
+	{
+		if( dynamic_cast< FormObject* > ( item ) ||
+			dynamic_cast< PageComment* > ( item ) )
+				items.append( item );
+	}
 
-	QList< FormObject* > objs;
+	m_ids.clear();
+	m_comments.clear();
+	m_docs.clear();
+	m_currentLines.clear();
+	m_loadingImages.clear();
+	m_loadedImages.clear();
+	m_current = nullptr;
+	m_currentPoly = nullptr;
 
-	foreach( QGraphicsItem * item, items )
-	{
-		auto * obj = dynamic_cast< FormObject* > ( item );
+	if( items.isEmpty() )
+		return;
 
-		if( obj )
-			objs.append( obj );
-		else
-		{
-			auto * snap = dynamic_cast< GridSnap* > ( item );
+	m_zOrder->clear();
+	m_objectSnap->clear();
 
-			if( !snap )
-				q->scene()->removeItem( item );
-			else
-				items.removeOne( item );
-		}
-	}
+	m_isClearing = true;
 
-	std::reverse( objs.begin(), objs.end() );
+	// Take the page out of the scene, so deleted items don't touch
+	// selection, index and update regions of the scene one by one.
+	QGraphicsScene * scene = q->scene();
 
-	foreach( FormObject * obj, objs )
+	if( scene )
 	{
-		auto * item = dynamic_cast< QGraphicsItem* > ( obj );
+		scene->clearSelection();
+
+		const bool blocked = scene->blockSignals( true );
+		const auto method = scene->itemIndexMethod();
+
+		scene->setItemIndexMethod( QGraphicsScene::NoIndex );
+		scene->removeItem( q );
+
+		qDeleteAll( items );
 
-		if( item )
-			q->scene()->removeItem( item );
+		scene->addItem( q );
+		scene->setItemIndexMethod( method );
+		scene->blockSignals( blocked );
 	}
+	else
+		qDeleteAll( items );
 
-	foreach( QGraphicsItem * item, items )
-		delete item;
+	m_isClearing = false;
 }
 
 template< class Elem, class Config >
@@ -380,6 +571,8 @@ PagePrivate::createElem( const Config & cfg )
 
 	e->setCfg( cfg );
 
+	m_zOrder->update( e );
+
 	m_ids.append( e->objectId() );
 
 	return e;
@@ -394,6 +587,8 @@ PagePrivate::createElemWithRect( const Config & cfg, const QRectF & rect )
 
 	e->setCfg( cfg );
 
+	m_zOrder->update( e );
+
 	m_ids.append( e->objectId() );
 
 	return e;
@@ -408,6 +603,8 @@ PagePrivate::createText( const Cfg::Text & cfg )
 
 	text->setCfg( cfg );
 
+	m_zOrder->update( text );
+
 	m_ids.append( text->objectId() );
 
 	m_docs.insert( text->document(), text );
@@ -425,15 +622,119 @@ PagePrivate::createGroup( const Cfg::Group & cfg )
 
 	group->setCfg( cfg );
 
+	m_zOrder->update( group );
+
 	addIds( group );
 
 	return group;
 }
 
+void
+PagePrivate::removeId( const QString & id )
+{
+	m_ids.removeOne( id );
+
+	auto it = m_loadingImages.find( id );
+
+	if( it != m_loadingImages.end() )
+		it.value() = true;
+}
+
+void
+PagePrivate::pruneLoadedImages()
+{
+	QSet< QString > ids;
+
+	for( int i = 0; i < m_undoStack->count(); ++i )
+	{
+		const auto * c = dynamic_cast< const UndoObjects* > (
+			m_undoStack->command( i ) );
+
+		if( c )
+		{
+			foreach( const QString & id, c->objectIds() )
+				ids.insert( id );
+		}
+	}
+
+	for( auto it = m_loadedImages.begin(); it != m_loadedImages.end(); )
+	{
+		if( !ids.contains( it.key() ) )
+			it = m_loadedImages.erase( it );
+		else
+			++it;
+	}
+}
+
+void
+PagePrivate::trimUndoHistory()
+{
+	const int index = m_undoStack->index();
+	qint64 size = 0;
+
+	for( int i = m_undoStack->count() - 1; i >= 0; --i )
+	{
+		// QUndoStack gives commands as const, but they are ours.
+		auto * c = const_cast< QUndoCommand* > ( m_undoStack->command( i ) );
+
+		if( c->isObsolete() )
+			break;
+
+		const auto * p = dynamic_cast< const UndoPayload* > ( c );
+
+		size += ( p ? p->payloadSize() : qint64( sizeof( QUndoCommand ) ) );
+
+		// The last done command is kept whatever its size is.
+		if( size > c_undoHistoryBudget && i < index - 1 )
+		{
+			// QUndoStack can't drop the oldest commands, so they give up
+			// their configurations and are skipped and deleted by undo.
+			for( ; i >= 0; --i )
+			{
+				c = const_cast< QUndoCommand* > ( m_undoStack->command( i ) );
+
+				if( c->isObsolete() )
+					break;
+
+				auto * old = dynamic_cast< UndoPayload* > ( c );
+
+				if( old )
+					old->releasePayload();
+
+				c->setObsolete( true );
+			}
+
+			break;
+		}
+	}
+}
+
+void
+PagePrivate::dropObsoleteCommands()
+{
+	// All commands before an obsolete one are obsolete too, undo of them
+	// changes nothing and only deletes them.
+	if( m_undoStack->index() == 0 ||
+		!m_undoStack->command( m_undoStack->index() - 1 )->isObsolete() )
+			return;
+
+	m_isDroppingCommands = true;
+
+	while( m_undoStack->index() > 0 )
+		m_undoStack->undo();
+
+	m_isDroppingCommands = false;
+
+	m_objectSnap->invalidate();
+
+	if( !m_loadedImages.isEmpty() )
+		pruneLoadedImages();
+}
+
 void
 PagePrivate::clearIds( FormGroup * group )
 {
-	m_ids.removeOne( group->objectId() );
+	removeId( group->objectId() );
 
 	foreach( QGraphicsItem * item, group->childItems() )
 	{
@@ -441,7 +742,7 @@ PagePrivate::clearIds( FormGroup * group )
 
 		if( obj )
 		{
-			m_ids.removeOne( obj->objectId() );
+			removeId( obj->objectId() );
 
 			auto * childGroup = dynamic_cast< FormGroup* > ( item );
 
@@ -534,6 +835,45 @@ PagePrivate::selection()
 	return res;
 }
 
+void
+PagePrivate::simplifyPolylines( const QList< FormPolyline* > & polys )
+{
+	const qreal tolerance =
+		MmPx::instance().fromMmX( c_polylineSimplifyTolerance );
+
+	UndoChangePoints::PointsAndIds origPoints;
+	UndoChangePoints::PointsAndIds newPoints;
+
+	for( const auto & poly : polys )
+	{
+		const QVector< QPointF > points = poly->simplified( tolerance );
+
+		if( points.size() < poly->points().size() )
+		{
+			origPoints.append( qMakePair( poly->objectId(), poly->points() ) );
+			newPoints.append( qMakePair( poly->objectId(), points ) );
+
+			poly->setPoints( points );
+		}
+	}
+
+	if( !newPoints.isEmpty() )
+	{
+		m_undoStack->push( new UndoChangePoints( q, origPoints, newPoints,
+			Page::tr( "Simplify Polylines" ) ) );
+
+		emit q->changed();
+	}
+}
+
+void
+PagePrivate::finishCurrentPolyline()
+{
+	if( m_currentPoly &&
+		PageAction::instance()->isPolylineSimplificationEnabled() )
+			simplifyPolylines( QList< FormPolyline* > () << m_currentPoly );
+}
+
 qreal
 PagePrivate::searchAlignPoint( const QList< QGraphicsItem* > & items,
 	AlignPoint point )
@@ -671,6 +1011,22 @@ Page::undoStack() const
 	return d->m_undoStack;
 }
 
+qint64
+Page::undoHistorySize() const
+{
+	qint64 size = 0;
+
+	for( int i = 0; i < d->m_undoStack->count(); ++i )
+	{
+		const auto * c = d->m_undoStack->command( i );
+		const auto * p = dynamic_cast< const UndoPayload* > ( c );
+
+		size += ( p ? p->payloadSize() : qint64( sizeof( QUndoCommand ) ) );
+	}
+
+	return size;
+}
+
 const Cfg::Size &
 Page::size() const
 {
@@ -712,171 +1068,259 @@ Page::setGridStep( int s )
 
 	d->m_snap->setGridStep( s );
 
+	emit changed();
+
 	update();
 }
 
-Cfg::Page
-Page::cfg() const
+//! Append configuration of the object to the page's configuration.
+static inline void appendObjectCfg( Cfg::Page & c, QGraphicsItem * item )
 {
-	Cfg::Page c = d->m_cfg;
+	auto * obj = dynamic_cast< FormObject* > ( item );
 
-	Cfg::Size size;
-	size.set_width( MmPx::instance().toMmX( d->m_cfg.size().width() ) );
-	size.set_height( MmPx::instance().toMmY( d->m_cfg.size().height() ) );
-	c.set_size( size );
+	if( obj )
+	{
+		switch( obj->objectType() )
+		{
+			case FormObject::LineType :
+			{
+				auto * line = dynamic_cast< FormLine* > ( item );
+
+				if( line )
+					c.line().push_back( line->cfg() );
+			}
+				break;
 
-	c.line().clear();
-	c.polyline().clear();
-	c.text().clear();
-	c.image().clear();
-	c.group().clear();
-	c.rect().clear();
-	c.button().clear();
-	c.checkbox().clear();
-	c.combobox().clear();
-	c.radiobutton().clear();
-	c.hslider().clear();
-	c.vslider().clear();
-	c.spinbox().clear();
-	c.comments().clear();
+			case FormObject::PolylineType :
+			{
+				auto * poly = dynamic_cast< FormPolyline* > ( item );
 
-	for( const auto & comment : qAsConst( d->m_comments ) )
-		c.comments().push_back( comment->cfg() );
+				if( poly )
+					c.polyline().push_back( poly->cfg() );
+			}
+				break;
 
-	foreach( QGraphicsItem * item, childItems() )
+			case FormObject::TextType :
+			{
+				auto * text = dynamic_cast< FormText* > ( item );
+
+				if( text )
+					c.text().push_back( text->cfg() );
+			}
+				break;
+
+			case FormObject::ImageType :
+			{
+				auto * image = dynamic_cast< FormImage* > ( item );
+
+				if( image )
+					c.image().push_back( image->cfg() );
+			}
+				break;
+
+			case FormObject::RectType :
+			{
+				auto * rect = dynamic_cast< FormRect* > ( item );
+
+				if( rect )
+					c.rect().push_back( rect->cfg() );
+			}
+				break;
+
+			case FormObject::GroupType :
+			{
+				auto * group = dynamic_cast< FormGroup* > ( item );
+
+				if( group )
+					c.group().push_back( group->cfg() );
+			}
+				break;
+
+			case FormObject::ButtonType :
+			{
+				auto * btn = dynamic_cast< FormButton* > ( item );
+
+				if( btn )
+					c.button().push_back( btn->cfg() );
+			}
+				break;
+
+			case FormObject::CheckBoxType :
+			{
+				auto * chk = dynamic_cast< FormCheckBox* > ( item );
+
+				if( chk )
+					c.checkbox().push_back( chk->cfg() );
+			}
+				break;
+
+			case FormObject::RadioButtonType :
+			{
+				auto * r = dynamic_cast< FormRadioButton* > ( item );
+
+				if( r )
+					c.radiobutton().push_back( r->cfg() );
+			}
+				break;
+
+			case FormObject::ComboBoxType :
+			{
+				auto * cb = dynamic_cast< FormComboBox* > ( item );
+
+				if( cb )
+					c.combobox().push_back( cb->cfg() );
+			}
+				break;
+
+			case FormObject::SpinBoxType :
+			{
+				auto * sb = dynamic_cast< FormSpinBox* > ( item );
+
+				if( sb )
+					c.spinbox().push_back( sb->cfg() );
+			}
+				break;
+
+			case FormObject::HSliderType :
+			{
+				auto * hs = dynamic_cast< FormHSlider* > ( item );
+
+				if( hs )
+					c.hslider().push_back( hs->cfg() );
+			}
+				break;
+
+			case FormObject::VSliderType :
+			{
+				auto * vs = dynamic_cast< FormVSlider* > ( item );
+
+				if( vs )
+					c.vslider().push_back( vs->cfg() );
+			}
+				break;
+
+			default :
+				break;
+		}
+	}
+}
+
+//! \return Does the group contain object with one of the given ids?
+static inline bool containsIds( FormGroup * group, const QStringList & ids )
+{
+	foreach( QGraphicsItem * item, group->childItems() )
 	{
 		auto * obj = dynamic_cast< FormObject* > ( item );
 
 		if( obj )
 		{
-			switch( obj->objectType() )
-			{
-				case FormObject::LineType :
-				{
-					auto * line = dynamic_cast< FormLine* > ( item );
+			if( ids.contains( obj->objectId() ) )
+				return true;
 
-					if( line )
-						c.line().push_back( line->cfg() );
-				}
-					break;
+			auto * childGroup = dynamic_cast< FormGroup* > ( item );
 
-				case FormObject::PolylineType :
-				{
-					auto * poly = dynamic_cast< FormPolyline* > ( item );
+			if( childGroup && containsIds( childGroup, ids ) )
+				return true;
+		}
+	}
 
-					if( poly )
-						c.polyline().push_back( poly->cfg() );
-				}
-					break;
+	return false;
+}
 
-				case FormObject::TextType :
-				{
-					auto * text = dynamic_cast< FormText* > ( item );
+Cfg::Page
+Page::cfg() const
+{
+	Cfg::Page c = commonCfg();
 
-					if( text )
-						c.text().push_back( text->cfg() );
-				}
-					break;
+	foreach( QGraphicsItem * item, childItems() )
+		appendObjectCfg( c, item );
 
-				case FormObject::ImageType :
-				{
-					auto * image = dynamic_cast< FormImage* > ( item );
+	return c;
+}
 
-					if( image )
-						c.image().push_back( image->cfg() );
-				}
-					break;
+Cfg::Page
+Page::commonCfg() const
+{
+	Cfg::Page c;
 
-				case FormObject::RectType :
-				{
-					auto * rect = dynamic_cast< FormRect* > ( item );
+	c.set_gridStep( d->m_cfg.gridStep() );
 
-					if( rect )
-						c.rect().push_back( rect->cfg() );
-				}
-					break;
+	Cfg::Size size;
+	size.set_width( MmPx::instance().toMmX( d->m_cfg.size().width() ) );
+	size.set_height( MmPx::instance().toMmY( d->m_cfg.size().height() ) );
+	c.set_size( size );
 
-				case FormObject::GroupType :
-				{
-					auto * group = dynamic_cast< FormGroup* > ( item );
+	for( const auto & comment : qAsConst( d->m_comments ) )
+		c.comments().push_back( comment->cfg() );
 
-					if( group )
-						c.group().push_back( group->cfg() );
-				}
-					break;
+	c.set_tabName( objectId() );
 
-				case FormObject::ButtonType :
-				{
-					auto * btn = dynamic_cast< FormButton* > ( item );
+	return c;
+}
 
-					if( btn )
-						c.button().push_back( btn->cfg() );
-				}
-					break;
+void
+Page::setCommonCfg( const Cfg::Page & c )
+{
+	d->setCommonCfg( c );
 
-				case FormObject::CheckBoxType :
-				{
-					auto * chk = dynamic_cast< FormCheckBox* > ( item );
+	update();
+}
 
-					if( chk )
-						c.checkbox().push_back( chk->cfg() );
-				}
-					break;
+QMap< QString, Cfg::Page >
+Page::objectsCfg( const QStringList & ids ) const
+{
+	QMap< QString, Cfg::Page > res;
 
-				case FormObject::RadioButtonType :
-				{
-					auto * r = dynamic_cast< FormRadioButton* > ( item );
+	foreach( QGraphicsItem * item, childItems() )
+	{
+		auto * obj = dynamic_cast< FormObject* > ( item );
 
-					if( r )
-						c.radiobutton().push_back( r->cfg() );
-				}
-					break;
+		if( !obj )
+			continue;
 
-				case FormObject::ComboBoxType :
-				{
-					auto * cb = dynamic_cast< FormComboBox* > ( item );
+		if( !ids.isEmpty() && !ids.contains( obj->objectId() ) )
+		{
+			auto * group = dynamic_cast< FormGroup* > ( item );
 
-					if( cb )
-						c.combobox().push_back( cb->cfg() );
-				}
-					break;
+			if( !group || !containsIds( group, ids ) )
+				continue;
+		}
 
-				case FormObject::SpinBoxType :
-				{
-					auto * sb = dynamic_cast< FormSpinBox* > ( item );
+		Cfg::Page c;
+		c.set_tabName( objectId() );
+		appendObjectCfg( c, item );
+		res.insert( obj->objectId(), c );
+	}
 
-					if( sb )
-						c.spinbox().push_back( sb->cfg() );
-				}
-					break;
+	return res;
+}
 
-				case FormObject::HSliderType :
-				{
-					auto * hs = dynamic_cast< FormHSlider* > ( item );
+void
+Page::replaceObjects( const QStringList & ids, const Cfg::Page & c )
+{
+	QList< QGraphicsItem* > items;
 
-					if( hs )
-						c.hslider().push_back( hs->cfg() );
-				}
-					break;
+	foreach( QGraphicsItem * item, childItems() )
+	{
+		auto * obj = dynamic_cast< FormObject* > ( item );
 
-				case FormObject::VSliderType :
-				{
-					auto * vs = dynamic_cast< FormVSlider* > ( item );
+		if( obj && ids.contains( obj->objectId() ) )
+		{
+			items.append( item );
 
-					if( vs )
-						c.vslider().push_back( vs->cfg() );
-				}
-					break;
+			d->m_currentLines.removeOne( dynamic_cast< FormLine* > ( item ) );
 
-				default :
-					break;
-			}
+			if( item == d->m_currentPoly )
+				d->m_currentPoly = nullptr;
 		}
 	}
 
-	c.set_tabName( objectId() );
+	if( !items.isEmpty() )
+		deleteItems( items, false );
 
-	return c;
+	d->createObjects( c );
+
+	update();
 }
 
 void
@@ -1034,7 +1478,7 @@ Page::group( const QList< QGraphicsItem* > & items,
 	{
 		d->m_current = group;
 
-		group->setZValue( d->currentZValue() + 1.0 );
+		d->m_zOrder->setZValue( group, d->currentZValue() + 1.0 );
 
 		if( pushUndoCommand )
 			d->m_undoStack->push( new UndoGroup( this, group->objectId() ) );
@@ -1073,14 +1517,16 @@ Page::alignVerticalTop()
 		const qreal y = d->searchAlignPoint( items,
 			PagePrivate::AlignVertTopPoint );
 
+		QList< QPair< FormObject*, QPointF > > moves;
+
 		foreach( QGraphicsItem * item, items )
 		{
-			dynamic_cast< FormObject* > ( item )->setPosition(
-				QPointF( dynamic_cast< FormObject* > ( item )->
-					position().x(), y ) );
+			auto * obj = dynamic_cast< FormObject* > ( item );
+
+			moves.append( qMakePair( obj, QPointF( obj->position().x(), y ) ) );
 		}
 
-		emit changed();
+		moveObjects( moves, tr( "Align Vertical Top" ) );
 	}
 }
 
@@ -1094,20 +1540,21 @@ Page::alignVerticalCenter()
 		const qreal y = d->searchAlignPoint( items,
 			PagePrivate::AlignVertCenterPoint );
 
+		QList< QPair< FormObject*, QPointF > > moves;
+
 		foreach( QGraphicsItem * item, items )
 		{
-			const qreal iy = dynamic_cast< FormObject* > ( item )->
-				position().y();
+			auto * obj = dynamic_cast< FormObject* > ( item );
+
+			const qreal iy = obj->position().y();
 
 			const qreal cy = iy + item->boundingRect().height() / 2.0;
 
-			dynamic_cast< FormObject* > ( item )->setPosition(
-				QPointF( dynamic_cast< FormObject* > ( item )->
-						position().x(),
-					 iy + y - cy ) );
+			moves.append( qMakePair( obj,
+				QPointF( obj->position().x(), iy + y - cy ) ) );
 		}
 
-		emit changed();
+		moveObjects( moves, tr( "Align Vertical Center" ) );
 	}
 }
 
@@ -1121,17 +1568,17 @@ Page::alignVerticalBottom()
 		const qreal y = d->searchAlignPoint( items,
 			PagePrivate::AlignVertBottomPoint );
 
+		QList< QPair< FormObject*, QPointF > > moves;
+
 		foreach( QGraphicsItem * item, items )
 		{
-			dynamic_cast< FormObject* > ( item )->setPosition(
-				QPointF( dynamic_cast< FormObject* > ( item )->
-					position().x(), dynamic_cast< FormObject* > ( item )->
-						position().y() + y -
-					( dynamic_cast< FormObject* > ( item )->
-						position().y() + item->boundingRect().height() ) ) );
+			auto * obj = dynamic_cast< FormObject* > ( item );
+
+			moves.append( qMakePair( obj, QPointF( obj->position().x(),
+				y - item->boundingRect().height() ) ) );
 		}
 
-		emit changed();
+		moveObjects( moves, tr( "Align Vertical Bottom" ) );
 	}
 }
 
@@ -1145,13 +1592,16 @@ Page::alignHorizontalLeft()
 		const qreal x = d->searchAlignPoint( items,
 			PagePrivate::AlignHorLeftPoint );
 
+		QList< QPair< FormObject*, QPointF > > moves;
+
 		foreach( QGraphicsItem * item, items )
 		{
-			dynamic_cast< FormObject* > ( item )->setPosition(
-				QPointF( x, dynamic_cast< FormObject* > ( item )->position().y() ) );
+			auto * obj = dynamic_cast< FormObject* > ( item );
+
+			moves.append( qMakePair( obj, QPointF( x, obj->position().y() ) ) );
 		}
 
-		emit changed();
+		moveObjects( moves, tr( "Align Horizontal Left" ) );
 	}
 }
 
@@ -1165,20 +1615,21 @@ Page::alignHorizontalCenter()
 		const qreal x = d->searchAlignPoint( items,
 			PagePrivate::AlignHorCenterPoint );
 
+		QList< QPair< FormObject*, QPointF > > moves;
+
 		foreach( QGraphicsItem * item, items )
 		{
-			const qreal ix = dynamic_cast< FormObject* > ( item )->
-				position().x();
+			auto * obj = dynamic_cast< FormObject* > ( item );
 
-			const qreal cx = ix +
-				item->boundingRect().width() / 2.0;
+			const qreal ix = obj->position().x();
 
-			dynamic_cast< FormObject* > ( item )->setPosition(
-				QPointF( ix + x - cx,
-					dynamic_cast< FormObject* > ( item )->position().y() ) );
+			const qreal cx = ix + item->boundingRect().width() / 2.0;
+
+			moves.append( qMakePair( obj,
+				QPointF( ix + x - cx, obj->position().y() ) ) );
 		}
 
-		emit changed();
+		moveObjects( moves, tr( "Align Horizontal Center" ) );
 	}
 }
 
@@ -1192,14 +1643,59 @@ Page::alignHorizontalRight()
 		const qreal x = d->searchAlignPoint( items,
 			PagePrivate::AlignHorRightPoint );
 
+		QList< QPair< FormObject*, QPointF > > moves;
+
 		foreach( QGraphicsItem * item, items )
 		{
-			dynamic_cast< FormObject* > ( item )->setPosition(
-				QPointF( dynamic_cast< FormObject* > ( item )->position().x() + x -
-						( dynamic_cast< FormObject* > ( item )->position().x() + item->boundingRect().width() ),
-					dynamic_cast< FormObject* > ( item )->position().y() ) );
+			auto * obj = dynamic_cast< FormObject* > ( item );
+
+			moves.append( qMakePair( obj, QPointF(
+				x - item->boundingRect().width(), obj->position().y() ) ) );
 		}
 
+		moveObjects( moves, tr( "Align Horizontal Right" ) );
+	}
+}
+
+void
+Page::simplifyPolylines()
+{
+	QList< FormPolyline* > polys;
+
+	foreach( QGraphicsItem * item, d->selection() )
+	{
+		auto * poly = dynamic_cast< FormPolyline* > ( item );
+
+		if( poly )
+			polys.append( poly );
+	}
+
+	d->simplifyPolylines( polys );
+}
+
+void
+Page::moveObjects( const QList< QPair< FormObject*, QPointF > > & moves,
+	const QString & undoText )
+{
+	UndoMoveMany::DeltaAndIds deltas;
+	deltas.reserve( moves.size() );
+
+	for( const auto & m : moves )
+	{
+		const QPointF delta = m.second - m.first->position();
+
+		if( !delta.isNull() )
+		{
+			deltas.append( qMakePair( m.first->objectId(), delta ) );
+
+			m.first->setPosition( m.second, false );
+		}
+	}
+
+	if( !deltas.isEmpty() )
+	{
+		d->m_undoStack->push( new UndoMoveMany( this, deltas, undoText ) );
+
 		emit changed();
 	}
 }
@@ -1360,7 +1856,7 @@ Page::deleteItems( const QList< QGraphicsItem* > & items,
 			if( makeUndoCommand )
 				pushUndoDeleteCommand( d->m_undoStack, obj, this );
 
-			d->m_ids.removeOne( obj->objectId() );
+			d->removeId( obj->objectId() );
 
 			switch( obj->objectType() )
 			{
@@ -1423,7 +1919,8 @@ Page::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 
 	draw( painter, d->m_cfg.size().width(),
 		d->m_cfg.size().height(), d->m_cfg.gridStep(),
-		d->m_gridMode == ShowGrid );
+		d->m_gridMode == ShowGrid && !isLowDetail( levelOfDetail( painter ),
+			d->m_cfg.gridStep(), c_lodMinGridStep ) );
 }
 
 void
@@ -1568,10 +2065,12 @@ Page::contextMenuEvent( QGraphicsSceneContextMenuEvent * event )
 				c->setPos( event->scenePos() );
 				d->m_comments.append( c );
 
-				connect( c, &PageComment::changed, this, &Page::changed );
+				d->connectComment( c );
 
 				d->m_isCommentChanged = true;
 
+				d->updateModified();
+
 				emit changed();
 			} );
 	}
@@ -1595,6 +2094,8 @@ Page::contextMenuEvent( QGraphicsSceneContextMenuEvent * event )
 
 						d->m_isCommentChanged = true;
 
+						d->updateModified();
+
 						break;
 					}
 				}
@@ -1640,6 +2141,8 @@ Page::mouseMoveEvent( QGraphicsSceneMouseEvent * mouseEvent )
 					line->setLine( l.p1().x(), l.p1().y(),
 						l.p2().x() + delta.x(), l.p2().y() + delta.y() );
 
+					line->placeHandles();
+
 					d->handleMouseMoveInCurrentLines( mouseEvent->pos() );
 				}
 
@@ -1735,6 +2238,8 @@ Page::mousePressEvent( QGraphicsSceneMouseEvent * mouseEvent )
 
 				line->setLine( p.x(), p.y(), p.x(), p.y() );
 
+				line->placeHandles();
+
 				if( intersectedEnds && d->m_currentLines.size() == 1 &&
 					PageAction::instance()->testFlag( PageAction::Polyline ) )
 						d->m_polyline = true;
@@ -1755,6 +2260,8 @@ Page::mousePressEvent( QGraphicsSceneMouseEvent * mouseEvent )
 
 					if( d->m_currentPoly )
 					{
+						d->finishCurrentPolyline();
+
 						d->m_currentPoly->showHandles( false );
 
 						d->m_currentPoly = nullptr;
@@ -1888,7 +2395,7 @@ Elem * onReleaseWithRectPlacer( QGraphicsScene * scene, PagePrivate * d,
 
 		elem->setObjectId( id );
 
-		elem->setZValue( d->currentZValue() + 1.0 );
+		d->m_zOrder->setZValue( elem, d->currentZValue() + 1.0 );
 
 		d->m_ids.append( id );
 
@@ -1926,7 +2433,7 @@ Page::mouseReleaseEvent( QGraphicsSceneMouseEvent * mouseEvent )
 				{
 					if( !d->m_polyline )
 					{
-						line->setZValue( d->currentZValue() + 1.0 );
+						d->m_zOrder->setZValue( line, d->currentZValue() + 1.0 );
 
 						d->m_undoStack->push(
 							new UndoCreate< FormLine, Cfg::Line > (
@@ -1947,13 +2454,16 @@ Page::mouseReleaseEvent( QGraphicsSceneMouseEvent * mouseEvent )
 
 					line->setLine( l.p1().x(), l.p1().y(), p.x(), p.y() );
 
+					line->placeHandles();
+
 					if( d->m_polyline )
 					{
 						if( !d->m_currentLines.isEmpty() )
 						{
 							d->m_currentPoly = new FormPolyline( this, this );
 
-							d->m_currentPoly->setZValue( d->currentZValue() + 1.0 );
+							d->m_zOrder->setZValue( d->m_currentPoly,
+								d->currentZValue() + 1.0 );
 
 							const QString id =
 								d->m_currentLines.first()->objectId();
@@ -1983,6 +2493,8 @@ Page::mouseReleaseEvent( QGraphicsSceneMouseEvent * mouseEvent )
 
 						if( d->m_currentPoly->isClosed() )
 						{
+							d->finishCurrentPolyline();
+
 							d->m_currentPoly->showHandles( false );
 
 							d->m_current = d->m_currentPoly;
@@ -2052,7 +2564,7 @@ Page::mouseReleaseEvent( QGraphicsSceneMouseEvent * mouseEvent )
 
 					rect->setRectangle( r.normalized(), false );
 
-					rect->setZValue( d->currentZValue() + 1.0 );
+					d->m_zOrder->setZValue( rect, d->currentZValue() + 1.0 );
 
 					d->m_undoStack->push( new UndoCreate< FormRect, Cfg::Rect > (
 						this, rect->objectId() ) );
@@ -2171,12 +2683,30 @@ Page::hoverMoveEvent( QGraphicsSceneHoverEvent * event )
 	event->ignore();
 }
 
+QVariant
+Page::itemChange( GraphicsItemChange change, const QVariant & value )
+{
+	if( change == ItemChildRemovedChange && !d.isNull() &&
+		!d->m_isClearing )
+	{
+		auto * item = value.value< QGraphicsItem* > ();
+
+		if( !d->m_objectSnap.isNull() )
+			d->m_objectSnap->removeItem( item );
+
+		if( !d->m_zOrder.isNull() )
+			d->m_zOrder->remove( item );
+	}
+
+	return QGraphicsObject::itemChange( change, value );
+}
+
 void
 Page::dragEnterEvent( QGraphicsSceneDragDropEvent * event )
 {
 	d->m_snap->setSnapPos( event->pos() );
 
-	if( event->mimeData()->hasImage() )
+	if( event->mimeData()->hasImage() || event->mimeData()->hasUrls() )
 		event->acceptProposedAction();
 	else
 		QGraphicsObject::dragEnterEvent( event );
@@ -2187,7 +2717,7 @@ Page::dragMoveEvent( QGraphicsSceneDragDropEvent * event )
 {
 	d->m_snap->setSnapPos( event->pos() );
 
-	if( event->mimeData()->hasImage() )
+	if( event->mimeData()->hasImage() || event->mimeData()->hasUrls() )
 		event->acceptProposedAction();
 	else
 		QGraphicsObject::dragMoveEvent( event );
@@ -2196,39 +2726,35 @@ Page::dragMoveEvent( QGraphicsSceneDragDropEvent * event )
 void
 Page::dropEvent( QGraphicsSceneDragDropEvent * event )
 {
-	if( event->mimeData()->hasImage() )
-	{
-		d->hideHandlesOfCurrent();
-
-		auto * image = new FormImage( this, this );
-
-		image->setZValue( d->currentZValue() + 1.0 );
+	QStringList files;
 
-		const QString id = d->id();
+	for( const auto & url : event->mimeData()->urls() )
+	{
+		if( url.isLocalFile() && QImageReader( url.toLocalFile() ).canRead() )
+			files.append( url.toLocalFile() );
+	}
 
-		image->setObjectId( id );
+	if( !files.isEmpty() || event->mimeData()->hasImage() )
+	{
+		d->hideHandlesOfCurrent();
 
-		d->m_undoStack->push( new UndoCreate< FormImage, Cfg::Image > (
-			this, image->objectId() ) );
+		d->m_snap->setSnapPos( event->pos() );
 
-		d->m_ids.append( id );
+		QPointF pos = ( PageAction::instance()->isSnapEnabled() ?
+			d->m_snap->snapPos() : event->pos() );
 
-		if( PageAction::instance()->mode() == PageAction::Select )
+		if( !files.isEmpty() )
 		{
-			image->setFlag( QGraphicsItem::ItemIsSelectable, true );
+			for( const auto & fileName : qAsConst( files ) )
+			{
+				d->importImage( pos, fileName, QImage() );
 
-			image->setSelected( true );
+				pos += QPointF( d->m_cfg.gridStep(), d->m_cfg.gridStep() );
+			}
 		}
-
-		d->m_snap->setSnapPos( event->pos() );
-
-		if( PageAction::instance()->isSnapEnabled() )
-			image->setPos( d->m_snap->snapPos() );
 		else
-			image->setPos( event->pos() );
-
-		image->setImage( qvariant_cast< QImage >
-			( event->mimeData()->imageData() ) );
+			d->importImage( pos, QString(),
+				qvariant_cast< QImage > ( event->mimeData()->imageData() ) );
 
 		event->acceptProposedAction();
 
@@ -2275,6 +2801,19 @@ Page::setCurrentPolyLine( FormPolyline * line )
 	d->m_polyline = true;
 }
 
+void
+Page::applyLoadedImage( FormImage * img )
+{
+	const auto it = d->m_loadedImages.constFind( img->objectId() );
+
+	if( it != d->m_loadedImages.cend() )
+	{
+		img->setImage( it.value().first, it.value().second );
+
+		d->m_objectSnap->invalidate();
+	}
+}
+
 QString
 Page::nextId()
 {
@@ -2285,7 +2824,7 @@ Page::nextId()
 }
 
 FormObject *
-Page::clone() const
+Page::clone( QGraphicsItem * ) const
 {
 	return nullptr;
 }
@@ -2293,10 +2832,6 @@ Page::clone() const
 bool
 Page::isCommentChanged() const
 {
-	for( const auto & c : qAsConst( d->m_comments ) )
-		if( c->isChanged() )
-			return true;
-
 	return d->m_isCommentChanged;
 }
 
@@ -2307,6 +2842,14 @@ Page::clearCommentChanged()
 		[] ( auto & c ) { c->setChanged( false ); } );
 
 	d->m_isCommentChanged = false;
+
+	d->updateModified();
+}
+
+bool
+Page::isModified() const
+{
+	return d->m_isModified;
 }
 
 qreal
@@ -2318,11 +2861,27 @@ Page::topZ() const
 qreal
 Page::bottomZ() const
 {
-	qreal z = 0.0;
+	return d->m_zOrder->bottom();
+}
 
-	findZBorder( childItems(), z, true, std::less< qreal > () );
+void
+Page::updateRenderCache()
+{
+	applyRenderCache( childItems() );
 
-	return z;
+	update();
+}
+
+void
+Page::clear()
+{
+	d->clear();
+}
+
+void
+Page::updateZOrder( QGraphicsItem * item )
+{
+	d->m_zOrder->update( item );
 }
 
 } /* namespace Core */
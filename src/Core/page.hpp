@@ -27,6 +27,7 @@
 #include <QGraphicsObject>
 #include <QScopedPointer>
 #include <QTextDocument>
+#include <QMap>
 
 // Prototyper include.
 #include "types.hpp"
@@ -69,6 +70,7 @@ class PagePrivate;
 class FormLine;
 class FormPolyline;
 class FormText;
+class FormImage;
 class FormGroup;
 class GridSnap;
 
@@ -87,6 +89,8 @@ class Page final
 signals:
 	//! Changed.
 	void changed();
+	//! Modified state changed.
+	void modifiedChanged( bool modified );
 
 public:
 	explicit Page( Cfg::Page & c, QGraphicsItem * parent = 0 );
@@ -98,6 +102,8 @@ public:
 
 	//! \return Undo stack.
 	QUndoStack * undoStack() const;
+	//! \return Approximate memory used by the undo history.
+	qint64 undoHistorySize() const;
 
 	//! \return Size.
 	const Cfg::Size & size() const;
@@ -118,6 +124,18 @@ public:
 	Cfg::Page cfg() const;
 	//! Set configuration.
 	void setCfg( const Cfg::Page & c );
+	//! \return Configuration without objects.
+	Cfg::Page commonCfg() const;
+	//! Set size, grid step and comments from the configuration.
+	void setCommonCfg( const Cfg::Page & c );
+	//! \return Configurations of top-level objects by their ids, each in
+	//! its own page's configuration. If \a ids isn't empty only objects
+	//! with these ids or groups containing them are returned.
+	QMap< QString, Cfg::Page > objectsCfg(
+		const QStringList & ids = QStringList() ) const;
+	//! Replace top-level objects with the given ids by objects of the
+	//! configuration, other objects are kept. No undo commands are made.
+	void replaceObjects( const QStringList & ids, const Cfg::Page & c );
 
 	//! Switch to select mode.
 	void switchToSelectMode();
@@ -160,9 +178,21 @@ public:
 	//! Align horizontal right.
 	void alignHorizontalRight();
 
+	//! Simplify selected polylines.
+	void simplifyPolylines();
+
+	//! Apply render cache setting to all objects.
+	void updateRenderCache();
+
+	//! Move objects to the given positions as one undoable action.
+	void moveObjects( const QList< QPair< FormObject*, QPointF > > & moves,
+		const QString & undoText );
+
 	//! Delete items.
 	void deleteItems( const QList< QGraphicsItem* > & items,
 		bool makeUndoCommand = true );
+	//! Delete all objects without undo commands.
+	void clear();
 
 	QRectF boundingRect() const override;
 
@@ -189,17 +219,22 @@ public:
 	QString nextId();
 
 	//! Clone object.
-	FormObject * clone() const override;
+	FormObject * clone( QGraphicsItem * parent = nullptr ) const override;
 
 	//! \return Is comment changed?
 	bool isCommentChanged() const;
 	//! Clear comment changed flag.
 	void clearCommentChanged();
 
+	//! \return Is page modified since last save?
+	bool isModified() const;
+
 	//! \return Max Z index on the page.
 	qreal topZ() const;
 	//! \return Min Z index on the page.
 	qreal bottomZ() const;
+	//! Z-value of the object was changed, update Z-order.
+	void updateZOrder( QGraphicsItem * item );
 
 public slots:
 	//! Rename form.
@@ -223,6 +258,8 @@ protected:
 	void dragEnterEvent( QGraphicsSceneDragDropEvent * event ) override;
 	void dragMoveEvent( QGraphicsSceneDragDropEvent * event ) override;
 	void dropEvent( QGraphicsSceneDragDropEvent * event ) override;
+	QVariant itemChange( GraphicsItemChange change,
+		const QVariant & value ) override;
 
 protected:
 	friend class UndoAddLineToPoly;
@@ -238,6 +275,8 @@ protected:
 	void setCurrentLine( FormLine * line );
 	//! Set current polyline.
 	void setCurrentPolyLine( FormPolyline * line );
+	//! Set image loaded for the placeholder that was deleted while loading.
+	void applyLoadedImage( FormImage * img );
 	//! Create element.
 	template< class Elem >
 	FormObject * createElement( const QString & id )
@@ -330,7 +369,11 @@ protected:
 
 		obj->setObjectId( id );
 
-		dynamic_cast< QGraphicsItem* > ( obj )->setZValue( d->currentZValue() + 1.0 );
+		auto * item = dynamic_cast< QGraphicsItem* > ( obj );
+
+		item->setZValue( d->currentZValue() + 1.0 );
+
+		updateZOrder( item );
 
 		d->m_ids.append( id );
 
@@ -27,6 +27,9 @@
 #include <QScopedPointer>
 #include <QList>
 #include <QMap>
+#include <QHash>
+#include <QPair>
+#include <QImage>
 #include <QPointF>
 
 // C++ include.
@@ -68,6 +71,8 @@ class FormLine;
 class FormText;
 class FormGroup;
 class GridSnap;
+class ObjectSnap;
+class ZOrder;
 class FormPolyline;
 class PageComment;
 
@@ -89,18 +94,22 @@ public:
 		,	m_snap( 0 )
 		,	m_polyline( false )
 		,	m_isCommentChanged( false )
+		,	m_isModified( false )
 		,	m_currentPoly( 0 )
 		,	m_undoStack( 0 )
+		,	m_isClearing( false )
+		,	m_isDroppingCommands( false )
 	{
 	}
 
 	//! Init.
 	void init();
+	//! Update modified flag.
+	void updateModified();
+	//! Connect comment.
+	void connectComment( PageComment * c );
 	//! \return Current Z-value.
 	qreal currentZValue() const;
-	//! \return Current Z-value.
-	void currentZValue( const QList< QGraphicsItem* > & items,
-		qreal & z, bool initZ ) const;
 	//! \return Start point for line.
 	QPointF lineStartPoint( const QPointF & point,
 		bool & intersected, bool & intersectedEnds,
@@ -117,7 +126,12 @@ public:
 	QString id();
 	//! Update form from the configuration.
 	void updateFromCfg();
-	//! Clear form.
+	//! Set size, grid step and comments from the configuration.
+	void setCommonCfg( const Cfg::Page & c );
+	//! Create objects of the configuration.
+	void createObjects( const Cfg::Page & c );
+	//! Clear form. All objects are deleted at once while the page is
+	//! detached from the scene, no undo commands are made.
 	void clear();
 	//! Create text.
 	FormText * createText( const Cfg::Text & cfg );
@@ -129,6 +143,14 @@ public:
 	//! Create element with rect.
 	template< class Elem, class Config >
 	Elem * createElemWithRect( const Config & cfg, const QRectF & rect );
+	//! Remove ID of the deleted object.
+	void removeId( const QString & id );
+	//! Drop loaded images no undo command can recreate a placeholder for.
+	void pruneLoadedImages();
+	//! Make commands beyond the undo history budget obsolete.
+	void trimUndoHistory();
+	//! Drop obsolete commands reached by undo.
+	void dropObsoleteCommands();
 	//! Clear IDs.
 	void clearIds( FormGroup * group );
 	//! Add IDs.
@@ -140,6 +162,15 @@ public:
 	void hideHandlesOfCurrent();
 	//! Selection.
 	QList< QGraphicsItem* > selection();
+	//! Simplify polylines as one undoable action.
+	void simplifyPolylines( const QList< FormPolyline* > & polys );
+	//! Simplify current polyline when it's finished, if enabled.
+	void finishCurrentPolyline();
+	//! Place image at the given position. Placeholder is shown until the
+	//! image is read from \a fileName, or taken from \a image, and
+	//! downscaled on worker thread.
+	void importImage( const QPointF & pos, const QString & fileName,
+		const QImage & image );
 	//! Is comment under mosue?
 	bool isCommentUnderMouse() const;
 
@@ -183,10 +214,21 @@ public:
 	QList< FormLine* > m_currentLines;
 	//! Grid snap.
 	GridSnap * m_snap;
+	//! Snap to objects.
+	QScopedPointer< ObjectSnap > m_objectSnap;
+	//! Objects ordered by Z-value.
+	QScopedPointer< ZOrder > m_zOrder;
+	//! IDs of images being loaded, true if placeholder was deleted.
+	QHash< QString, bool > m_loadingImages;
+	//! Images loaded for placeholders deleted while loading, they are
+	//! set again when undo command recreates the placeholder.
+	QHash< QString, QPair< QImage, QImage > > m_loadedImages;
 	//! Make polyline.
 	bool m_polyline;
-	//! Comment was added/deleted;
+	//! Comment was added/deleted/changed;
 	bool m_isCommentChanged;
+	//! Is page modified?
+	bool m_isModified;
 	//! Current polyline.
 	FormPolyline * m_currentPoly;
 	//! IDs
@@ -197,6 +239,10 @@ public:
 	QMap< QObject*, FormText* > m_docs;
 	//! Comments.
 	QList< PageComment* > m_comments;
+	//! Objects are being deleted by clear().
+	bool m_isClearing;
+	//! Obsolete commands are being dropped.
+	bool m_isDroppingCommands;
 }; // class PagePrivate
 
 } /* namespace Core */
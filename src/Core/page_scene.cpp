@@ -103,13 +103,18 @@ PageScenePrivate::init()
 void
 PageScenePrivate::moveBy( const QPointF & delta )
 {
+	QList< QPair< FormObject*, QPointF > > moves;
+
 	foreach( QGraphicsItem * item, q->selectedItems() )
 	{
 		auto * obj = dynamic_cast< FormObject* > ( item );
 
 		if( obj )
-			obj->setPosition( obj->position() + delta );
+			moves.append( qMakePair( obj, obj->position() + delta ) );
 	}
+
+	if( m_form && !moves.isEmpty() )
+		m_form->moveObjects( moves, PageScene::tr( "Move" ) );
 }
 
 bool
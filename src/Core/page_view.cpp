@@ -142,6 +142,9 @@ PageView::setScaleValue( qreal s )
 	t.scale( d->m_scale, d->m_scale );
 
 	setTransform( t );
+
+	// Antialiasing is not visible on zoomed out page but costs a lot.
+	setRenderHint( QPainter::Antialiasing, d->m_scale >= c_lodAntialiasingZoom );
 }
 
 qreal
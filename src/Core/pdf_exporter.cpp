@@ -58,7 +58,7 @@ class PdfExporterPrivate
 	:	public ExporterPrivate
 {
 public:
-	PdfExporterPrivate( const Cfg::Project & cfg, PdfExporter * parent )
+	PdfExporterPrivate( const ProjectSnapshot & cfg, PdfExporter * parent )
 		:	ExporterPrivate( cfg, parent )
 	{
 	}
@@ -236,7 +236,7 @@ PdfExporterPrivate::printDocument( const QTextDocument & doc, QPdfWriter & pdf,
 // PdfExporter
 //
 
-PdfExporter::PdfExporter( const Cfg::Project & project )
+PdfExporter::PdfExporter( const ProjectSnapshot & project )
 	:	Exporter( QScopedPointer< ExporterPrivate >
 			( new PdfExporterPrivate( project, this ) ) )
 {
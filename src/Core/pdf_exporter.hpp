@@ -42,7 +42,7 @@ class PdfExporter final
 	:	public Exporter
 {
 public:
-	explicit PdfExporter( const Cfg::Project & project );
+	explicit PdfExporter( const ProjectSnapshot & project );
 	~PdfExporter();
 
 	//! Export documentation.
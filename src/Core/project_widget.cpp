@@ -36,6 +36,7 @@
 #include "project_window.hpp"
 #include "utils.hpp"
 #include "constants.hpp"
+#include "undo_history.hpp"
 
 // Qt include.
 #include <QTabWidget>
@@ -46,6 +47,7 @@
 #include <QAction>
 #include <QUndoStack>
 #include <QUndoGroup>
+#include <QHash>
 
 
 namespace Prototyper {
@@ -88,6 +90,7 @@ public:
 		,	m_tabBar( nullptr )
 		,	m_undoGroup( nullptr )
 		,	m_isTabRenamed( false )
+		,	m_isModified( false )
 	{
 	}
 
@@ -97,6 +100,12 @@ public:
 	void newProject();
 	//! Add page.
 	void addPage( const Cfg::Page & cfg, bool showGrid );
+	//! Set page modified.
+	void setPageModified( Page * page, bool modified );
+	//! Update modified flag.
+	void updateModified();
+	//! Drop cached configuration of the page.
+	void invalidatePageCfg( Page * page );
 
 	//! Parent.
 	ProjectWidget * q;
@@ -118,6 +127,14 @@ public:
 	QUndoGroup * m_undoGroup;
 	//! Is tab renamed?
 	bool m_isTabRenamed;
+	//! Modified pages.
+	QSet< Page* > m_modifiedPages;
+	//! Is modified?
+	bool m_isModified;
+	//! Configurations of pages built on last save.
+	QHash< Page*, Cfg::Page > m_pageCfgs;
+	//! Saved undo history.
+	UndoHistory m_history;
 }; // class ProjectWidgetPrivate
 
 void
@@ -156,6 +173,11 @@ ProjectWidgetPrivate::init()
 void
 ProjectWidgetPrivate::newProject()
 {
+	// Don't switch to every page that is being removed.
+	const bool blocked = m_tabs->blockSignals( true );
+
+	m_undoGroup->setActiveStack( nullptr );
+
 	for( int i = 1; i < m_tabNames.size(); )
 	{
 		QWidget * tab = m_tabs->widget( i );
@@ -166,15 +188,38 @@ ProjectWidgetPrivate::newProject()
 
 		ProjectWidget::disconnect( tab, nullptr, nullptr, nullptr );
 
-		m_undoGroup->removeStack( m_forms.at( i - 1 )->page()->undoStack() );
+		auto * view = qobject_cast< PageView* > ( tab );
+
+		if( view )
+		{
+			ProjectWidget::disconnect( view->pageScene(), nullptr,
+				m_window, nullptr );
+			ProjectWidget::disconnect( view->page(), nullptr, q, nullptr );
 
-		m_forms.at( i - 1 )->page()->undoStack()->deleteLater();
+			m_undoGroup->removeStack( view->page()->undoStack() );
+
+			view->page()->undoStack()->deleteLater();
+
+			// Delete objects at once, so the deferred deletion of the tab
+			// has only an empty scene to destroy.
+			view->page()->clear();
+		}
 
 		tab->deleteLater();
 	}
 
+	m_tabs->blockSignals( blocked );
+
 	m_forms.clear();
 
+	m_modifiedPages.clear();
+
+	m_pageCfgs.clear();
+
+	updateModified();
+
+	m_history.reset();
+
 	static const QString projectDescTabName =
 		ProjectWidget::tr( "Description" );
 
@@ -219,9 +264,48 @@ ProjectWidgetPrivate::addPage( const Cfg::Page & cfg,
 	ProjectWidget::connect( form->page(), &Page::changed,
 		q, &ProjectWidget::changed );
 
+	Page * page = form->page();
+
+	ProjectWidget::connect( page, &Page::modifiedChanged, q,
+		[this, page] ( bool modified ) { setPageModified( page, modified ); } );
+	ProjectWidget::connect( page, &Page::changed, q,
+		[this, page] () { invalidatePageCfg( page ); } );
+	ProjectWidget::connect( page->undoStack(), &QUndoStack::indexChanged, q,
+		[this, page] () { invalidatePageCfg( page ); } );
+
 	emit q->pageAdded( form );
 }
 
+void
+ProjectWidgetPrivate::setPageModified( Page * page, bool modified )
+{
+	if( modified )
+		m_modifiedPages.insert( page );
+	else
+		m_modifiedPages.remove( page );
+
+	updateModified();
+}
+
+void
+ProjectWidgetPrivate::updateModified()
+{
+	const bool modified = !m_modifiedPages.isEmpty() || m_isTabRenamed;
+
+	if( modified != m_isModified )
+	{
+		m_isModified = modified;
+
+		emit q->modifiedChanged( m_isModified );
+	}
+}
+
+void
+ProjectWidgetPrivate::invalidatePageCfg( Page * page )
+{
+	m_pageCfgs.remove( page );
+}
+
 
 //
 // ProjectWidget
@@ -298,6 +382,9 @@ ProjectWidget::setProject( const Cfg::Project & cfg )
 	for( ; it != last; ++it )
 		d->addPage( *it, d->m_cfg.showGrid() );
 
+	// Pages keep their items, configuration is rebuilt from them on save.
+	d->m_cfg.page().clear();
+
 	TopGui::instance()->projectWindow()->tabsList()->model()->
 		setStringList( d->m_tabNames );
 
@@ -359,7 +446,11 @@ ProjectWidget::renameTab( const QString & oldName )
 			d->m_tabNames[ index ] = dlg.name();
 
 			if( index > 0 )
+			{
 				d->m_forms[ index - 1 ]->page()->renameForm( dlg.name() );
+
+				d->invalidatePageCfg( d->m_forms[ index - 1 ]->page() );
+			}
 			else
 				d->m_cfg.description().set_tabName( dlg.name() );
 
@@ -400,6 +491,14 @@ ProjectWidget::deletePage( const QString & name )
 
 			d->m_forms.removeAt( index - 1 );
 
+			disconnect( form->page(), nullptr, this, nullptr );
+
+			d->setPageModified( form->page(), false );
+
+			d->invalidatePageCfg( form->page() );
+
+			d->m_history.removePage( form->page() );
+
 			d->m_tabs->removeTab( index );
 
 			disconnect( tab, nullptr, nullptr, nullptr );
@@ -434,6 +533,8 @@ ProjectWidget::tabChanged( int index )
 {
 	if( index > 0 )
 	{
+		d->m_history.restore( d->m_forms.at( index - 1 )->page() );
+
 		d->m_undoGroup->setActiveStack(
 			d->m_forms.at( index - 1 )->page()->undoStack() );
 	}
@@ -451,6 +552,8 @@ void
 ProjectWidget::setTabRenamed( bool on )
 {
 	d->m_isTabRenamed = on;
+
+	d->updateModified();
 }
 
 bool
@@ -470,6 +573,35 @@ ProjectWidget::clearCommentChanged()
 		f->page()->clearCommentChanged();
 }
 
+bool
+ProjectWidget::isModified() const
+{
+	return d->m_isModified;
+}
+
+const QSet< Page* > &
+ProjectWidget::modifiedPages() const
+{
+	return d->m_modifiedPages;
+}
+
+const Cfg::Page &
+ProjectWidget::pageCfg( Page * page )
+{
+	auto it = d->m_pageCfgs.find( page );
+
+	if( it == d->m_pageCfgs.end() || d->m_modifiedPages.contains( page ) )
+		it = d->m_pageCfgs.insert( page, page->cfg() );
+
+	return it.value();
+}
+
+UndoHistory *
+ProjectWidget::undoHistory() const
+{
+	return &d->m_history;
+}
+
 } /* namespace Core */
 
 } /* namespace Prototyper */
@@ -26,6 +26,7 @@
 // Qt include.
 #include <QWidget>
 #include <QScopedPointer>
+#include <QSet>
 
 QT_BEGIN_NAMESPACE
 class QTabWidget;
@@ -40,10 +41,13 @@ namespace Core {
 namespace Cfg {
 
 class Project;
+class Page;
 
 } /* namespace Cfg */
 
+class Page;
 class PageView;
+class UndoHistory;
 class ProjectDescTab;
 class ProjectWindow;
 
@@ -66,6 +70,8 @@ signals:
 	void pageAdded( Prototyper::Core::PageView * );
 	//! Page deleted.
 	void pageDeleted( Prototyper::Core::PageView * );
+	//! Modified state changed.
+	void modifiedChanged( bool modified );
 
 public:
 	explicit ProjectWidget( Cfg::Project & cfg,
@@ -109,6 +115,17 @@ public:
 	//! Clear comment changed flag.
 	void clearCommentChanged();
 
+	//! \return Is any page modified or tab renamed since last save?
+	bool isModified() const;
+	//! \return Modified pages.
+	const QSet< Page* > & modifiedPages() const;
+	//! \return Configuration of the page. Rebuilt only if the page
+	//! was changed since the last call.
+	const Cfg::Page & pageCfg( Page * page );
+
+	//! \return Saved undo history.
+	UndoHistory * undoHistory() const;
+
 public slots:
 	//! Add page.
 	void addPage();
@@ -43,6 +43,7 @@
 #include "constants.hpp"
 #include "utils.hpp"
 #include "version.hpp"
+#include "undo_history.hpp"
 
 // Qt include.
 #include <QMenuBar>
@@ -56,6 +57,9 @@
 #include <QToolBar>
 #include <QActionGroup>
 #include <QImage>
+#include <QImageReader>
+#include <QUrl>
+#include <QInputDialog>
 #include <QColorDialog>
 #include <QMimeData>
 #include <QDrag>
@@ -66,6 +70,11 @@
 #include <QFile>
 #include <QStringListModel>
 #include <QScrollArea>
+#include <QVBoxLayout>
+#include <QPointer>
+#include <QTimer>
+#include <QLabel>
+#include <QStatusBar>
 
 
 namespace Prototyper {
@@ -118,12 +127,15 @@ public:
 		,	m_zoomOut( nullptr )
 		,	m_zoomOriginal( nullptr )
 		,	m_duplicate( nullptr )
+		,	m_simplifyPolylines( nullptr )
 		,	m_toTop( nullptr )
 		,	m_toBottom( nullptr )
 		,	m_up( nullptr )
 		,	m_down( nullptr )
 		,	m_propertiesDock( nullptr )
 		,	m_propertiesScrollArea( nullptr )
+		,	m_properties( nullptr )
+		,	m_undoHistorySize( nullptr )
 	{
 	}
 
@@ -140,8 +152,16 @@ public:
 	//! Enable/disable editing.
 	void enableEditing( const QList< QGraphicsItem* > & children,
 		bool on );
+	//! Show widget with properties, hide the previous one.
+	void showProperties( QWidget * panel );
+	//! Show size of undo history of the current page.
+	void updateUndoHistorySize();
 	//! Update cfg.
 	void updateCfg();
+	//! Fill project's configuration from the widgets.
+	void fillCfg( Cfg::Project & cfg ) const;
+	//! \return Snapshot of the current project.
+	ProjectSnapshot snapshot() const;
 	//! Prepare to draw with rect placer.
 	void prepareDrawingWithRectPlacer( bool editable = false );
 	//! Clear edit mode in texts.
@@ -211,6 +231,7 @@ public:
 	QAction * m_zoomOut;
 	QAction * m_zoomOriginal;
 	QAction * m_duplicate;
+	QAction * m_simplifyPolylines;
 	QAction * m_toTop;
 	QAction * m_toBottom;
 	QAction * m_up;
@@ -219,6 +240,16 @@ public:
 	QDockWidget * m_propertiesDock;
 	//! Scroll area for properties.
 	QScrollArea * m_propertiesScrollArea;
+	//! Holder of widgets with properties.
+	QWidget * m_properties;
+	//! Shown widget with properties.
+	QPointer< QWidget > m_currentProperties;
+	//! Widgets with properties shared by objects of the same type.
+	PropertiesPanels m_propertiesPanels;
+	//! Coalesces selection changes.
+	QTimer m_selectionTimer;
+	//! Size of undo history.
+	QLabel * m_undoHistorySize;
 	//! Added forms.
 	QList< PageView* > m_addedForms;
 	//! Deleted forms.
@@ -262,6 +293,12 @@ ProjectWindowPrivate::init()
 		QIcon( QStringLiteral( ":/Core/img/document-save-as.png" ) ),
 		ProjectWindow::tr( "Save Project As" ) );
 
+	QAction * keepUndoHistory = file->addAction(
+		ProjectWindow::tr( "Save Undo History" ) );
+	keepUndoHistory->setCheckable( true );
+	keepUndoHistory->setChecked(
+		PageAction::instance()->isUndoHistoryPersistent() );
+
 	file->addSeparator();
 
 	QMenu * exportMenu = file->addMenu(
@@ -302,8 +339,17 @@ ProjectWindowPrivate::init()
 	m_propertiesScrollArea->setWidgetResizable( true );
 	m_propertiesDock->setWidget( m_propertiesScrollArea );
 	m_propertiesDock->setMinimumWidth( 250 );
-	auto w = new QWidget( m_propertiesScrollArea );
-	m_propertiesScrollArea->setWidget( w );
+	m_properties = new QWidget( m_propertiesScrollArea );
+	auto * propertiesLayout = new QVBoxLayout( m_properties );
+	propertiesLayout->setMargin( 0 );
+	propertiesLayout->setSpacing( 0 );
+	m_propertiesScrollArea->setWidget( m_properties );
+
+	m_selectionTimer.setSingleShot( true );
+	m_selectionTimer.setInterval( 0 );
+
+	ProjectWindow::connect( &m_selectionTimer, &QTimer::timeout,
+		q, &ProjectWindow::updateSelection );
 
 	q->addDockWidget( Qt::LeftDockWidgetArea, m_tabsList );
 	q->addDockWidget( Qt::RightDockWidgetArea, m_propertiesDock );
@@ -590,6 +636,19 @@ ProjectWindowPrivate::init()
 	snapGrid->setCheckable( true );
 	snapGrid->setChecked( true );
 
+	QAction * snapObjects = form->addAction(
+		ProjectWindow::tr( "Snap Objects" ) );
+	snapObjects->setCheckable( true );
+	snapObjects->setChecked( PageAction::instance()->isObjectSnapEnabled() );
+
+	QAction * renderCache = form->addAction(
+		ProjectWindow::tr( "Cache Rendering" ) );
+	renderCache->setCheckable( true );
+	renderCache->setChecked( PageAction::instance()->isRenderCacheEnabled() );
+
+	QAction * maxImageSize = form->addAction(
+		ProjectWindow::tr( "Max Image Size" ) );
+
 	form->addSeparator();
 
 	m_duplicate = form->addAction( QIcon( QStringLiteral( ":/Core/img/edit-copy.png" ) ),
@@ -598,6 +657,16 @@ ProjectWindowPrivate::init()
 	m_duplicate->setShortcut( ProjectWindow::tr( "Ctrl+D" ) );
 	m_duplicate->setEnabled( false );
 
+	m_simplifyPolylines = form->addAction(
+		ProjectWindow::tr( "Simplify Polylines" ) );
+	m_simplifyPolylines->setEnabled( false );
+
+	QAction * simplifyFinished = form->addAction(
+		ProjectWindow::tr( "Simplify Finished Polylines" ) );
+	simplifyFinished->setCheckable( true );
+	simplifyFinished->setChecked(
+		PageAction::instance()->isPolylineSimplificationEnabled() );
+
 	form->addSeparator();
 
 	form->addAction( m_zoomIn );
@@ -655,6 +724,15 @@ ProjectWindowPrivate::init()
 	redoAction->setIcon( QIcon( QStringLiteral( ":/Core/img/edit-redo.png" ) ) );
 	form->addAction( redoAction );
 
+	m_undoHistorySize = new QLabel( q );
+	q->statusBar()->addPermanentWidget( m_undoHistorySize );
+
+	ProjectWindow::connect( m_widget->undoGroup(), &QUndoGroup::indexChanged,
+		q, [this] () { updateUndoHistorySize(); } );
+	ProjectWindow::connect( m_widget->undoGroup(),
+		&QUndoGroup::activeStackChanged,
+		q, [this] () { updateUndoHistorySize(); } );
+
 	QMenu * help = q->menuBar()->addMenu( ProjectWindow::tr( "&Help" ) );
 	QAction * about = help->addAction( QIcon( QStringLiteral( ":/Core/img/prototyper.png" ) ),
 		ProjectWindow::tr( "About" ) );
@@ -667,6 +745,12 @@ ProjectWindowPrivate::init()
 		q, &ProjectWindow::showHideGrid );
 	ProjectWindow::connect( snapGrid, &QAction::toggled,
 		q, &ProjectWindow::snapGrid );
+	ProjectWindow::connect( snapObjects, &QAction::toggled,
+		q, &ProjectWindow::snapObjects );
+	ProjectWindow::connect( renderCache, &QAction::toggled,
+		q, &ProjectWindow::renderCache );
+	ProjectWindow::connect( maxImageSize, &QAction::triggered,
+		q, &ProjectWindow::setMaxImageSize );
 	ProjectWindow::connect( m_gridStep, &QAction::triggered,
 		q, QOverload<>::of( &ProjectWindow::setGridStep ) );
 	ProjectWindow::connect( newForm, &QAction::triggered,
@@ -679,6 +763,8 @@ ProjectWindowPrivate::init()
 		q, &ProjectWindow::saveProject );
 	ProjectWindow::connect( saveProjectAs, &QAction::triggered,
 		q, &ProjectWindow::saveProjectAs );
+	ProjectWindow::connect( keepUndoHistory, &QAction::toggled,
+		q, &ProjectWindow::saveUndoHistory );
 	ProjectWindow::connect( m_widget, &ProjectWidget::changed,
 		q, &ProjectWindow::projectChanged );
 	ProjectWindow::connect( m_select, &QAction::toggled,
@@ -747,7 +833,11 @@ ProjectWindowPrivate::init()
 		q, &ProjectWindow::zoomOut );
 	ProjectWindow::connect( m_duplicate, &QAction::triggered,
 		q, &ProjectWindow::duplicate );
-	ProjectWindow::connect( m_widget->undoGroup(), &QUndoGroup::cleanChanged,
+	ProjectWindow::connect( m_simplifyPolylines, &QAction::triggered,
+		q, &ProjectWindow::simplifyPolylines );
+	ProjectWindow::connect( simplifyFinished, &QAction::toggled,
+		q, &ProjectWindow::simplifyFinishedPolylines );
+	ProjectWindow::connect( m_widget, &ProjectWidget::modifiedChanged,
 		q, &ProjectWindow::canUndoChanged );
 	ProjectWindow::connect( m_widget->descriptionTab()->editor(),
 		&TextEditor::undoAvailable,
@@ -821,18 +911,75 @@ ProjectWindowPrivate::enableEditing( const QList< QGraphicsItem* > & children,
 	}
 }
 
+void
+ProjectWindowPrivate::showProperties( QWidget * panel )
+{
+	if( m_currentProperties == panel )
+		return;
+
+	if( m_currentProperties )
+		m_currentProperties->hide();
+
+	m_currentProperties = panel;
+
+	if( panel )
+	{
+		if( m_properties->layout()->indexOf( panel ) == -1 )
+			m_properties->layout()->addWidget( panel );
+
+		panel->show();
+	}
+}
+
+void
+ProjectWindowPrivate::updateUndoHistorySize()
+{
+	const int index = m_widget->tabs()->currentIndex();
+
+	if( index > 0 && index - 1 < m_widget->pages().size() )
+	{
+		const qint64 size =
+			m_widget->pages().at( index - 1 )->page()->undoHistorySize();
+
+		m_undoHistorySize->setText( ProjectWindow::tr( "Undo history: %1 KB" )
+			.arg( ( size + 1023 ) / 1024 ) );
+	}
+	else
+		m_undoHistorySize->clear();
+}
+
 void
 ProjectWindowPrivate::updateCfg()
 {
-	m_cfg.description().set_tabName( m_widget->projectTabName() );
+	fillCfg( m_cfg );
+}
 
-	m_cfg.description().set_text(
+void
+ProjectWindowPrivate::fillCfg( Cfg::Project & cfg ) const
+{
+	cfg.description().set_tabName( m_widget->projectTabName() );
+
+	cfg.description().set_text(
 		m_widget->descriptionTab()->editor()->text() );
 
-	m_cfg.page().clear();
+	cfg.page().clear();
+	cfg.page().reserve( m_widget->pages().size() );
 
 	for( const auto & page : qAsConst( m_widget->pages() ) )
-		m_cfg.page().push_back( page->page()->cfg() );
+		cfg.page().push_back( m_widget->pageCfg( page->page() ) );
+}
+
+ProjectSnapshot
+ProjectWindowPrivate::snapshot() const
+{
+	QSharedPointer< Cfg::Project > cfg( new Cfg::Project );
+
+	cfg->set_defaultGridStep( m_cfg.defaultGridStep() );
+	cfg->set_showGrid( m_cfg.showGrid() );
+
+	fillCfg( *cfg );
+
+	return cfg;
 }
 
 void
@@ -921,6 +1068,9 @@ ProjectWindow::readProject( const QString & fileName )
 
 			d->m_widget->setProject( tag.get_cfg() );
 
+			// New project resets the history, so set its file afterwards.
+			d->m_widget->undoHistory()->setProjectFile( fileName );
+
 			setWindowModified( false );
 
 			setWindowTitle( tr( "Prototyper - %1[*]" )
@@ -1004,6 +1154,18 @@ ProjectWindow::showHideGrid( bool show )
 	setWindowModified( true );
 }
 
+void
+ProjectWindow::saveUndoHistory( bool on )
+{
+	PageAction::instance()->enableUndoHistoryPersistence( on );
+}
+
+void
+ProjectWindow::simplifyFinishedPolylines( bool on )
+{
+	PageAction::instance()->enablePolylineSimplification( on );
+}
+
 void
 ProjectWindow::snapGrid( bool on )
 {
@@ -1013,6 +1175,35 @@ ProjectWindow::snapGrid( bool on )
 	PageAction::instance()->enableSnap( on );
 }
 
+void
+ProjectWindow::snapObjects( bool on )
+{
+	PageAction::instance()->enableObjectSnap( on );
+}
+
+void
+ProjectWindow::renderCache( bool on )
+{
+	PageAction::instance()->enableRenderCache( on );
+
+	foreach( PageView * view, d->m_widget->pages() )
+		view->page()->updateRenderCache();
+}
+
+void
+ProjectWindow::setMaxImageSize()
+{
+	bool ok = false;
+
+	const int s = QInputDialog::getInt( this, tr( "Max Image Size..." ),
+		tr( "Imported images are downscaled to this width and height "
+			"in pixels, 0 keeps them as is:" ),
+		PageAction::instance()->maxImageSize(), 0, 65535, 256, &ok );
+
+	if( ok )
+		PageAction::instance()->setMaxImageSize( s );
+}
+
 void
 ProjectWindow::setGridStep( int step, bool forAll )
 {
@@ -1127,6 +1318,18 @@ ProjectWindow::saveProjectImpl( const QString & fileName )
 
 				file.close();
 
+				if( PageAction::instance()->isUndoHistoryPersistent() )
+				{
+					QList< Page* > pages;
+
+					for( const auto & view : qAsConst( d->m_widget->pages() ) )
+						pages.append( view->page() );
+
+					if( !d->m_widget->undoHistory()->save( d->m_fileName, pages ) )
+						QMessageBox::warning( this, tr( "Unable to Save Undo History..." ),
+							tr( "Unable to save undo history.\nUnable to open file." ) );
+				}
+
 				d->m_widget->cleanUndoGroup();
 
 				d->m_widget->descriptionTab()->editor()->document()->
@@ -1257,37 +1460,21 @@ ProjectWindow::insertImage()
 			tr( "Image Files (*.png *.jpg *.jpeg *.bmp)" ), nullptr,
 			QFileDialog::DontUseNativeDialog );
 
-	QApplication::processEvents();
-
 	if( !fileName.isEmpty() )
 	{
-		QImage image( fileName );
-
-		if( !image.isNull() )
+		if( QImageReader( fileName ).canRead() )
 		{
-			QApplication::processEvents();
-
 			auto * drag = new QDrag( this );
 			auto * mimeData = new QMimeData;
 
-			QPixmap p;
-			QSize s = image.size();
-
-			if( s.width() > 50 || s.height() > 50 )
-			{
-				s = s.boundedTo( QSize( 50, 50 ) );
-				p = QPixmap::fromImage(
-					image.scaled( s, Qt::KeepAspectRatio, Qt::SmoothTransformation ) );
-			}
-			else
-				p = QPixmap::fromImage( image );
+			// Image is read on drop, on worker thread.
+			QPixmap p( c_imagePlaceholderSize, c_imagePlaceholderSize );
+			p.fill( c_imagePlaceholderColor );
 
-			mimeData->setImageData( image );
+			mimeData->setUrls( QList< QUrl > () << QUrl::fromLocalFile( fileName ) );
 			drag->setMimeData( mimeData );
 			drag->setPixmap( p );
 
-			QApplication::processEvents();
-
 			drag->exec();
 		}
 		else
@@ -1523,6 +1710,7 @@ ProjectWindow::tabChanged( int index )
 		d->m_zoomOut->setEnabled( false );
 		d->m_zoomOriginal->setEnabled( false );
 		d->m_duplicate->setEnabled( false );
+		d->m_simplifyPolylines->setEnabled( false );
 		d->m_toTop->setEnabled( false );
 		d->m_up->setEnabled( false );
 		d->m_down->setEnabled( false );
@@ -1556,6 +1744,12 @@ ProjectWindow::zoomChanged()
 
 void
 ProjectWindow::selectionChanged()
+{
+	d->m_selectionTimer.start();
+}
+
+void
+ProjectWindow::updateSelection()
 {
 	const auto index = d->m_widget->tabs()->currentIndex();
 
@@ -1564,6 +1758,7 @@ ProjectWindow::selectionChanged()
 		const auto s = d->m_widget->pages().at( index - 1 )->pageScene()->selectedItems();
 
 		d->m_duplicate->setEnabled( !s.isEmpty() );
+		d->m_simplifyPolylines->setEnabled( !s.isEmpty() );
 
 		d->m_toTop->setEnabled( !s.isEmpty() );
 		d->m_up->setEnabled( !s.isEmpty() );
@@ -1596,39 +1791,11 @@ ProjectWindow::selectionChanged()
 		else
 			d->m_ungroup->setEnabled( false );
 
-		if( s.size() == 1 )
-		{
-			auto * o = dynamic_cast< FormObject* > ( s.first() );
+		auto * o = ( s.size() == 1 ? dynamic_cast< FormObject* > ( s.first() ) :
+			nullptr );
 
-			if( o )
-			{
-				auto * widget = o->properties( this );
-
-				if( widget )
-				{
-					d->m_propertiesScrollArea->setWidget( widget );
-					widget->show();
-				}
-				else
-				{
-					auto w = new QWidget( d->m_propertiesScrollArea );
-					d->m_propertiesScrollArea->setWidget( w );
-					w->show();
-				}
-			}
-			else
-			{
-				auto w = new QWidget( d->m_propertiesScrollArea );
-				d->m_propertiesScrollArea->setWidget( w );
-				w->show();
-			}
-		}
-		else
-		{
-			auto w = new QWidget( d->m_propertiesScrollArea );
-			d->m_propertiesScrollArea->setWidget( w );
-			w->show();
-		}
+		d->showProperties( o ? o->propertiesPanel( d->m_propertiesPanels,
+			d->m_properties ) : nullptr );
 	}
 }
 
@@ -1668,9 +1835,7 @@ ProjectWindow::exportToPDf()
 
 		if( canModify )
 		{
-			d->updateCfg();
-
-			PdfExporter exporter( d->m_cfg );
+			PdfExporter exporter( d->snapshot() );
 
 			exporter.exportToDoc( fileName );
 		}
@@ -1718,9 +1883,7 @@ ProjectWindow::exportToHtml()
 
 		if( canModify )
 		{
-			d->updateCfg();
-
-			HtmlExporter exporter( d->m_cfg );
+			HtmlExporter exporter( d->snapshot() );
 
 			exporter.exportToDoc( fileName );
 		}
@@ -1753,9 +1916,7 @@ ProjectWindow::exportToSvg()
 	if( !dirName.isEmpty() )
 	{
 		try {
-			d->updateCfg();
-
-			SvgExporter exporter( d->m_cfg );
+			SvgExporter exporter( d->snapshot() );
 
 			exporter.exportToDoc( dirName );
 		}
@@ -1909,32 +2070,10 @@ ProjectWindow::canUndoChanged( bool canUndo )
 {
 	Q_UNUSED( canUndo )
 
-	QList< QUndoStack* > stacks = d->m_widget->undoGroup()->stacks();
-
-	bool can = false;
-
-	if( !d->m_addedForms.isEmpty() )
-		can = true;
-	else if( !d->m_deletedForms.isEmpty() )
-		can = true;
-	else if( d->m_widget->descriptionTab()->editor()->document()->isUndoAvailable() )
-		can = true;
-	else if( d->m_widget->isTabRenamed() )
-		can = true;
-	else if( d->m_widget->isCommentChanged() )
-		can = true;
-	else
-	{
-		foreach( QUndoStack * s, stacks )
-		{
-			if( !s->isClean() )
-			{
-				can = true;
-
-				break;
-			}
-		}
-	}
+	const bool can = !d->m_addedForms.isEmpty() ||
+		!d->m_deletedForms.isEmpty() ||
+		d->m_widget->descriptionTab()->editor()->document()->isUndoAvailable() ||
+		d->m_widget->isModified();
 
 	if( can )
 		setWindowModified( true );
@@ -2031,6 +2170,8 @@ ProjectWindow::duplicate()
 
 					if( g )
 					{
+						d->m_widget->pages().at( idx - 1 )->page()->updateZOrder( g );
+
 						g->setFlag( QGraphicsItem::ItemIsSelectable, true );
 						g->setSelected( true );
 					}
@@ -2067,6 +2208,8 @@ void changeZ( const QList< QGraphicsItem* > & s, qreal delta, Page * page )
 			newZ.append( qMakePair( o->objectId(), z ) );
 
 			i->setZValue( z );
+
+			page->updateZOrder( i );
 		}
 	}
 
@@ -2125,6 +2268,12 @@ ProjectWindow::lower()
 	}
 }
 
+void
+ProjectWindow::simplifyPolylines()
+{
+	PageAction::instance()->page()->simplifyPolylines();
+}
+
 void
 ProjectWindow::toBottom()
 {
@@ -85,8 +85,18 @@ private slots:
 	void quit();
 	//! Show/hide grid.
 	void showHideGrid( bool show );
+	//! Enable/disable saving of undo history with the project.
+	void saveUndoHistory( bool on );
+	//! Enable/disable simplification of finished polylines.
+	void simplifyFinishedPolylines( bool on );
 	//! Enable/disable snap to grid.
 	void snapGrid( bool on );
+	//! Enable/disable snap to objects.
+	void snapObjects( bool on );
+	//! Enable/disable raster cache of static items.
+	void renderCache( bool on );
+	//! Set max size of imported images.
+	void setMaxImageSize();
 	//! Set grid step.
 	void setGridStep();
 	//! Open project.
@@ -175,8 +185,12 @@ private slots:
 	void zoomChanged();
 	//! Selection changed.
 	void selectionChanged();
+	//! Update actions and properties for the current selection.
+	void updateSelection();
 	//! Duplicate selection.
 	void duplicate();
+	//! Simplify selected polylines.
+	void simplifyPolylines();
 	//! Bring to top.
 	void toTop();
 	//! Raise.
@@ -45,7 +45,7 @@ class SvgExporterPrivate
 	:	public ExporterPrivate
 {
 public:
-	SvgExporterPrivate( const Cfg::Project & cfg, SvgExporter * parent )
+	SvgExporterPrivate( const ProjectSnapshot & cfg, SvgExporter * parent )
 		:	ExporterPrivate( cfg, parent )
 	{
 	}
@@ -96,7 +96,7 @@ SvgExporterPrivate::createImages( const QString & dir )
 // SvgExporter
 //
 
-SvgExporter::SvgExporter( const Cfg::Project & project )
+SvgExporter::SvgExporter( const ProjectSnapshot & project )
 	:	Exporter( QScopedPointer< ExporterPrivate >
 			( new SvgExporterPrivate( project, this ) ) )
 {
@@ -42,7 +42,7 @@ class SvgExporter final
 	:	public Exporter
 {
 public:
-	explicit SvgExporter( const Cfg::Project & project );
+	explicit SvgExporter( const ProjectSnapshot & project );
 	~SvgExporter();
 
 	//! Export documentation.
@@ -0,0 +1,1029 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2016-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Prototyper include.
+#include "undo_history.hpp"
+#include "page.hpp"
+#include "project_cfg.hpp"
+#include "top_gui.hpp"
+#include "project_window.hpp"
+#include "form_actions.hpp"
+#include "form_undo_commands.hpp"
+
+// Qt include.
+#include <QUndoStack>
+#include <QUndoCommand>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QTextStream>
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QVector>
+#include <QMessageBox>
+#include <QTimer>
+
+
+namespace Prototyper {
+
+namespace Core {
+
+static const quint32 c_historyMagic = 0x50524855;
+static const quint32 c_historyVersion = 2;
+
+
+//
+// StateDelta
+//
+
+//! Delta between two states of the page. State is the list of entries,
+//! one per object. Resulting state is the prefix of the source state,
+//! entries of the delta and the suffix of the source state.
+struct StateDelta {
+	//! Count of entries taken from the beginning of the source.
+	qint32 m_prefix = 0;
+	//! Count of entries taken from the end of the source.
+	qint32 m_suffix = 0;
+	//! Entries in between.
+	QStringList m_entries;
+}; // struct StateDelta
+
+static inline QDataStream & operator << ( QDataStream & s, const StateDelta & d )
+{
+	s << d.m_prefix << d.m_suffix << d.m_entries;
+
+	return s;
+}
+
+static inline QDataStream & operator >> ( QDataStream & s, StateDelta & d )
+{
+	s >> d.m_prefix >> d.m_suffix >> d.m_entries;
+
+	return s;
+}
+
+//! \return Delta that makes \a to from \a from.
+static inline StateDelta makeDelta( const QStringList & from,
+	const QStringList & to )
+{
+	StateDelta d;
+
+	const int max = qMin( from.size(), to.size() );
+
+	while( d.m_prefix < max && from.at( d.m_prefix ) == to.at( d.m_prefix ) )
+		++d.m_prefix;
+
+	while( d.m_suffix < max - d.m_prefix &&
+		from.at( from.size() - 1 - d.m_suffix ) ==
+			to.at( to.size() - 1 - d.m_suffix ) )
+				++d.m_suffix;
+
+	d.m_entries = to.mid( d.m_prefix, to.size() - d.m_prefix - d.m_suffix );
+
+	return d;
+}
+
+//! \return State made from \a from with the given delta.
+static inline QStringList applyDelta( const QStringList & from,
+	const StateDelta & d )
+{
+	QStringList res = from.mid( 0, d.m_prefix );
+	res.append( d.m_entries );
+	res.append( from.mid( from.size() - d.m_suffix ) );
+
+	return res;
+}
+
+//! Make equal leading and trailing entries of \a lines share data with
+//! the entries of \a with.
+static inline void shareLines( QStringList & lines, const QStringList & with )
+{
+	const StateDelta d = makeDelta( with, lines );
+
+	for( int i = 0; i < d.m_prefix; ++i )
+		lines[ i ] = with.at( i );
+
+	for( int i = 1; i <= d.m_suffix; ++i )
+		lines[ lines.size() - i ] = with.at( with.size() - i );
+}
+
+//! \return Page's configuration as text.
+static inline QString pageToText( const Cfg::Page & cfg )
+{
+	Cfg::Project project;
+	project.page().push_back( cfg );
+
+	Cfg::tag_Project< cfgfile::qstring_trait_t > tag( project );
+
+	QString data;
+	QTextStream stream( &data );
+
+	cfgfile::write_cfgfile( tag, stream );
+
+	stream.flush();
+
+	return data;
+}
+
+//! \return Page's configuration from text.
+static inline Cfg::Page textToPage( QString data )
+{
+	QTextStream stream( &data );
+
+	Cfg::tag_Project< cfgfile::qstring_trait_t > tag;
+
+	cfgfile::read_cfgfile( tag, stream, QStringLiteral( "history" ) );
+
+	return tag.get_cfg().page().front();
+}
+
+//! \return Entry of the state. First line of the entry is the object's
+//! id, empty for the page's own configuration, the rest is configuration.
+static inline QString makeEntry( const QString & key, const Cfg::Page & cfg )
+{
+	return key + QLatin1Char( '\n' ) + pageToText( cfg );
+}
+
+//! \return Key of the entry.
+static inline QString entryKey( const QString & entry )
+{
+	return entry.left( entry.indexOf( QLatin1Char( '\n' ) ) );
+}
+
+//! \return Configuration of the entry.
+static inline Cfg::Page entryCfg( const QString & entry )
+{
+	return textToPage( entry.mid( entry.indexOf( QLatin1Char( '\n' ) ) + 1 ) );
+}
+
+//! \return Entries of the state by keys.
+static inline QMap< QString, QString > stateEntries( const QStringList & state )
+{
+	QMap< QString, QString > res;
+
+	for( const auto & e : state )
+		res.insert( entryKey( e ), e );
+
+	return res;
+}
+
+//! \return State of the page, page's own configuration goes first,
+//! objects are sorted by id.
+static inline QStringList pageState( const Page * page )
+{
+	QMap< QString, QString > res;
+
+	res.insert( QString(), makeEntry( QString(), page->commonCfg() ) );
+
+	const auto objects = page->objectsCfg();
+
+	for( auto it = objects.cbegin(), last = objects.cend(); it != last; ++it )
+		res.insert( it.key(), makeEntry( it.key(), it.value() ) );
+
+	return res.values();
+}
+
+//! \return State of the page made from the previous one, only objects
+//! with the given ids are serialized again.
+static inline QStringList pageState( const Page * page,
+	const QStringList & prev, const QStringList & ids )
+{
+	QMap< QString, QString > res = stateEntries( prev );
+
+	res.insert( QString(), makeEntry( QString(), page->commonCfg() ) );
+
+	for( const auto & id : ids )
+		res.remove( id );
+
+	if( !ids.isEmpty() )
+	{
+		const auto objects = page->objectsCfg( ids );
+
+		for( auto it = objects.cbegin(), last = objects.cend(); it != last; ++it )
+			res.insert( it.key(), makeEntry( it.key(), it.value() ) );
+	}
+
+	return res.values();
+}
+
+//! \return Keys of objects' entries that differ in two states.
+static inline QStringList changedKeys( const QStringList & from,
+	const QStringList & to )
+{
+	const QMap< QString, QString > f = stateEntries( from );
+	const QMap< QString, QString > t = stateEntries( to );
+
+	QStringList res;
+
+	for( auto it = f.cbegin(), last = f.cend(); it != last; ++it )
+	{
+		if( !it.key().isEmpty() && t.value( it.key() ) != it.value() )
+			res.append( it.key() );
+	}
+
+	for( auto it = t.cbegin(), last = t.cend(); it != last; ++it )
+	{
+		if( !it.key().isEmpty() && !f.contains( it.key() ) )
+			res.append( it.key() );
+	}
+
+	return res;
+}
+
+//! Collect ids of objects changed by commands between two indexes of
+//! the stack. \return false if some command doesn't tell them.
+static inline bool changedObjects( const QUndoStack * stack, int from, int to,
+	QStringList & ids )
+{
+	if( from > to )
+		qSwap( from, to );
+
+	// Command was merged into the current one.
+	if( from == to )
+		--from;
+
+	if( from < 0 || to > stack->count() )
+		return false;
+
+	for( int i = from; i < to; ++i )
+	{
+		const auto * c = dynamic_cast< const UndoObjects* > ( stack->command( i ) );
+
+		if( !c )
+			return false;
+
+		ids.append( c->objectIds() );
+	}
+
+	return true;
+}
+
+
+//
+// PageHistory
+//
+
+//! Saved states of the page.
+class PageHistory final {
+public:
+	//! \return State with the given index, 0 is the oldest state.
+	const QStringList & state( int index );
+	//! \return Count of commands.
+	int count() const
+	{
+		return m_deltas.size();
+	}
+
+	//! Texts of the commands.
+	QStringList m_texts;
+	//! Latest state.
+	QStringList m_latest;
+	//! i-th delta makes state i from state i + 1.
+	QVector< StateDelta > m_deltas;
+	//! Decoded states.
+	QHash< int, QStringList > m_states;
+}; // class PageHistory
+
+const QStringList &
+PageHistory::state( int index )
+{
+	if( index >= count() )
+		return m_latest;
+
+	if( !m_states.contains( index ) )
+	{
+		int from = index + 1;
+
+		while( from < count() && !m_states.contains( from ) )
+			++from;
+
+		QStringList s = state( from );
+
+		for( int i = from - 1; i >= index; --i )
+		{
+			s = applyDelta( s, m_deltas.at( i ) );
+
+			m_states.insert( i, s );
+		}
+	}
+
+	return m_states[ index ];
+}
+
+static inline QDataStream & operator << ( QDataStream & s, const PageHistory & h )
+{
+	s << h.m_texts << h.m_latest << h.m_deltas;
+
+	return s;
+}
+
+static inline QDataStream & operator >> ( QDataStream & s, PageHistory & h )
+{
+	s >> h.m_texts >> h.m_latest >> h.m_deltas;
+
+	return s;
+}
+
+
+//
+// PageRecorder
+//
+
+//! States of the page recorded on each change of its undo stack. Only
+//! objects changed by the commands are serialized again.
+class PageRecorder final {
+public:
+	PageRecorder()
+		:	m_first( nullptr )
+		,	m_index( -1 )
+		,	m_count( 0 )
+		,	m_restoredOffset( 0 )
+		,	m_restoredCount( 0 )
+	{
+	}
+
+	//! Forget all states.
+	void clear();
+	//! Record state of the page at the current index of the undo stack.
+	void record( Page * page );
+	//! Set state with the given index.
+	void setState( int index, QStringList lines );
+	//! Take states from the history restored into the undo stack.
+	void setRestored( const QSharedPointer< PageHistory > & history,
+		const QUndoCommand * first );
+	//! \return Is state with the given index known?
+	bool hasState( int index ) const;
+	//! \return State with the given index.
+	QStringList state( int index ) const;
+
+private:
+	//! i-th state is the state after i commands, empty if unknown.
+	QVector< QStringList > m_states;
+	//! The oldest command in the stack.
+	const QUndoCommand * m_first;
+	//! Index of the last recorded state.
+	int m_index;
+	//! Count of commands at the last record.
+	int m_count;
+	//! History restored into the stack.
+	QSharedPointer< PageHistory > m_restored;
+	//! Index in the restored history of the state 0.
+	int m_restoredOffset;
+	//! Count of states available in the restored history.
+	int m_restoredCount;
+}; // class PageRecorder
+
+void
+PageRecorder::clear()
+{
+	m_states.clear();
+	m_first = nullptr;
+	m_index = -1;
+	m_count = 0;
+	m_restored.reset();
+	m_restoredOffset = 0;
+	m_restoredCount = 0;
+}
+
+void
+PageRecorder::record( Page * page )
+{
+	// Nothing will be saved, don't spend time on it.
+	if( !PageAction::instance()->isUndoHistoryPersistent() )
+	{
+		clear();
+
+		return;
+	}
+
+	const QUndoStack * stack = page->undoStack();
+	const int count = stack->count();
+	const int index = stack->index();
+	const QUndoCommand * first = ( count > 0 ? stack->command( 0 ) : nullptr );
+	int prev = m_index;
+
+	// Undo limit dropped the oldest command, so states are shifted.
+	if( m_first && first != m_first && stack->undoLimit() > 0 &&
+		count == stack->undoLimit() && index == count &&
+		m_states.size() > count )
+	{
+		m_states.removeFirst();
+		--prev;
+
+		if( m_restoredCount > 0 )
+		{
+			++m_restoredOffset;
+			--m_restoredCount;
+		}
+	}
+	// Undo deleted an obsolete command without undoing it, so the state
+	// before it is gone and the page is in the state after it.
+	else if( count == m_count - 1 && index == m_index - 1 &&
+		index < m_states.size() )
+	{
+		// Restored states after it are shifted, take them out of the history.
+		for( int i = index + 1; i < m_restoredCount; ++i )
+		{
+			if( m_states.at( i ).isEmpty() )
+				m_states[ i ] = m_restored->state( i + m_restoredOffset );
+		}
+
+		m_restoredCount = qMin( m_restoredCount, index );
+		m_states.remove( index );
+		prev = index;
+	}
+
+	m_first = first;
+	m_index = index;
+	m_count = count;
+
+	// Commands after the pushed one are gone.
+	m_states.resize( count + 1 );
+	m_restoredCount = qMin( m_restoredCount, count + 1 );
+
+	QStringList ids;
+
+	if( prev >= 0 && hasState( prev ) &&
+		changedObjects( stack, prev, index, ids ) )
+			setState( index, pageState( page, state( prev ), ids ) );
+	else
+		setState( index, pageState( page ) );
+}
+
+void
+PageRecorder::setState( int index, QStringList lines )
+{
+	if( m_states.size() <= index )
+		m_states.resize( index + 1 );
+
+	if( index > 0 && !m_states.at( index - 1 ).isEmpty() )
+		shareLines( lines, m_states.at( index - 1 ) );
+	else if( index + 1 < m_states.size() && !m_states.at( index + 1 ).isEmpty() )
+		shareLines( lines, m_states.at( index + 1 ) );
+
+	m_states[ index ] = lines;
+}
+
+void
+PageRecorder::setRestored( const QSharedPointer< PageHistory > & history,
+	const QUndoCommand * first )
+{
+	m_states = QVector< QStringList > ( history->count() + 1 );
+	m_states.last() = history->m_latest;
+	m_first = first;
+	m_index = history->count();
+	m_count = history->count();
+	m_restored = history;
+	m_restoredOffset = 0;
+	m_restoredCount = history->count() + 1;
+}
+
+bool
+PageRecorder::hasState( int index ) const
+{
+	return ( index < m_states.size() && ( !m_states.at( index ).isEmpty() ||
+		( m_restored && index < m_restoredCount ) ) );
+}
+
+QStringList
+PageRecorder::state( int index ) const
+{
+	if( !m_states.at( index ).isEmpty() )
+		return m_states.at( index );
+	else
+		return m_restored->state( index + m_restoredOffset );
+}
+
+
+//
+// UndoPageState
+//
+
+//! Undo command restored from the saved history. Only objects that
+//! differ in two states are replaced on the page.
+class UndoPageState final
+	:	public QUndoCommand
+	,	public UndoObjects
+{
+public:
+	UndoPageState( Page * page, const QSharedPointer< PageHistory > & history,
+		int index )
+		:	QUndoCommand( history->m_texts.at( index - 1 ) )
+		,	m_page( page )
+		,	m_history( history )
+		,	m_index( index )
+		,	m_undone( false )
+	{
+	}
+
+	void undo() override
+	{
+		m_undone = true;
+
+		apply( m_index, m_index - 1 );
+	}
+
+	void redo() override
+	{
+		if( m_undone )
+			apply( m_index - 1, m_index );
+	}
+
+	QStringList objectIds() const override
+	{
+		const QStringList from = m_history->state( m_index - 1 );
+
+		return changedKeys( from, m_history->state( m_index ) );
+	}
+
+private:
+	//! Change state of the page.
+	void apply( int from, int to )
+	{
+		try {
+			const QStringList current = m_history->state( from );
+			const QStringList target = m_history->state( to );
+			const QMap< QString, QString > entries = stateEntries( target );
+			const QStringList keys = changedKeys( current, target );
+
+			// Everything is read before the page is touched.
+			const bool isCommonChanged = ( !current.isEmpty() &&
+				!target.isEmpty() && current.first() != target.first() );
+			const Cfg::Page common = ( isCommonChanged ?
+				entryCfg( target.first() ) : Cfg::Page() );
+
+			QList< Cfg::Page > objects;
+
+			for( const auto & key : keys )
+			{
+				if( entries.contains( key ) )
+					objects.append( entryCfg( entries.value( key ) ) );
+			}
+
+			if( isCommonChanged )
+			{
+				Cfg::Page c = common;
+
+				// Comments are changed without undo commands.
+				c.comments() = m_page->commonCfg().comments();
+
+				m_page->setCommonCfg( c );
+			}
+
+			m_page->replaceObjects( keys, Cfg::Page() );
+
+			for( const auto & c : qAsConst( objects ) )
+				m_page->replaceObjects( QStringList(), c );
+		}
+		catch( const cfgfile::exception_t< cfgfile::qstring_trait_t > & x )
+		{
+			QMessageBox::warning( TopGui::instance()->projectWindow(),
+				ProjectWindow::tr( "Unable to Restore Undo History..." ),
+				ProjectWindow::tr( "Unable to restore undo history, "
+					"it will be dropped.\n%1" ).arg( x.desc() ) );
+
+			// The stack can't be cleared from its own command.
+			QUndoStack * stack = m_page->undoStack();
+
+			QTimer::singleShot( 0, stack, [stack] () { stack->clear(); } );
+		}
+
+		TopGui::instance()->projectWindow()->switchToSelectMode();
+	}
+
+private:
+	//! Page.
+	Page * m_page;
+	//! History.
+	QSharedPointer< PageHistory > m_history;
+	//! Index of the state after this command.
+	int m_index;
+	//! Undone?
+	bool m_undone;
+}; // class UndoPageState
+
+
+//
+// UndoHistoryPrivate
+//
+
+class UndoHistoryPrivate {
+public:
+	UndoHistoryPrivate()
+		:	m_isIndexRead( false )
+		,	m_isRestoring( false )
+	{
+	}
+
+	//! Forget history file.
+	void resetFile();
+	//! Read table of pages.
+	void readIndex();
+	//! \return Saved block of the page.
+	QByteArray readBlock( const QString & pageId );
+	//! Start recording states of the page.
+	void track( Page * page );
+	//! \return Block with the history of the page.
+	QByteArray makeBlock( Page * page );
+
+	//! File with the history.
+	QString m_fileName;
+	//! Offsets of the pages' blocks in the file.
+	QHash< QString, qint64 > m_offsets;
+	//! Is table of pages read?
+	bool m_isIndexRead;
+	//! Restored pages.
+	QSet< Page* > m_restored;
+	//! Recorded states of the pages.
+	QHash< Page*, PageRecorder > m_recorders;
+	//! Is history being restored into the stack?
+	bool m_isRestoring;
+}; // class UndoHistoryPrivate
+
+void
+UndoHistoryPrivate::resetFile()
+{
+	m_fileName.clear();
+	m_offsets.clear();
+	m_isIndexRead = false;
+	m_restored.clear();
+}
+
+void
+UndoHistoryPrivate::readIndex()
+{
+	if( m_isIndexRead )
+		return;
+
+	m_isIndexRead = true;
+
+	QFile file( m_fileName );
+
+	if( !file.open( QIODevice::ReadOnly ) )
+		return;
+
+	QDataStream stream( &file );
+	stream.setVersion( QDataStream::Qt_5_0 );
+
+	quint32 magic = 0, version = 0;
+
+	stream >> magic >> version;
+
+	const qint64 headerSize = file.pos();
+	const qint64 tableEnd = file.size() - qint64( sizeof( qint64 ) );
+
+	if( magic != c_historyMagic || version != c_historyVersion ||
+		tableEnd < headerSize )
+			return;
+
+	qint64 tablePos = 0;
+
+	file.seek( tableEnd );
+	stream >> tablePos;
+
+	if( stream.status() != QDataStream::Ok || tablePos < headerSize ||
+		tablePos > tableEnd || !file.seek( tablePos ) )
+			return;
+
+	stream >> m_offsets;
+
+	if( stream.status() != QDataStream::Ok )
+	{
+		m_offsets.clear();
+
+		return;
+	}
+
+	// Blocks lie between the header and the table.
+	for( auto it = m_offsets.begin(); it != m_offsets.end(); )
+	{
+		if( it.value() < headerSize || it.value() >= tablePos )
+			it = m_offsets.erase( it );
+		else
+			++it;
+	}
+}
+
+QByteArray
+UndoHistoryPrivate::readBlock( const QString & pageId )
+{
+	if( m_fileName.isEmpty() )
+		return QByteArray();
+
+	readIndex();
+
+	if( !m_offsets.contains( pageId ) )
+		return QByteArray();
+
+	QFile file( m_fileName );
+
+	if( !file.open( QIODevice::ReadOnly ) )
+		return QByteArray();
+
+	QDataStream stream( &file );
+	stream.setVersion( QDataStream::Qt_5_0 );
+
+	if( !file.seek( m_offsets.value( pageId ) ) )
+		return QByteArray();
+
+	QByteArray block;
+	stream >> block;
+
+	return ( stream.status() == QDataStream::Ok ? block : QByteArray() );
+}
+
+void
+UndoHistoryPrivate::track( Page * page )
+{
+	if( m_recorders.contains( page ) )
+		return;
+
+	m_recorders.insert( page, PageRecorder() );
+
+	QUndoStack * stack = page->undoStack();
+
+	QObject::connect( stack, &QUndoStack::indexChanged, stack,
+		[this, page] ()
+		{
+			auto it = m_recorders.find( page );
+
+			if( !m_isRestoring && it != m_recorders.end() )
+				it->record( page );
+		} );
+
+	m_recorders[ page ].record( page );
+}
+
+QByteArray
+UndoHistoryPrivate::makeBlock( Page * page )
+{
+	auto it = m_recorders.find( page );
+
+	if( it == m_recorders.end() )
+		return QByteArray();
+
+	const QUndoStack * stack = page->undoStack();
+
+	const int index = stack->index();
+
+	// Page may be changed without undo commands since the last record.
+	const QStringList latest = pageState( page );
+
+	// Such changes can't be undone, so earlier states get them too while
+	// the object is the same there.
+	QMap< QString, QString > stale;
+	QMap< QString, QString > fresh;
+
+	if( it->hasState( index ) )
+	{
+		const QStringList recorded = it->state( index );
+		const QMap< QString, QString > r = stateEntries( recorded );
+		const QMap< QString, QString > l = stateEntries( latest );
+
+		for( const auto & key : changedKeys( recorded, latest ) )
+		{
+			stale.insert( key, r.value( key ) );
+			fresh.insert( key, l.value( key ) );
+		}
+	}
+
+	it->setState( index, latest );
+
+	// States before enabling of the persistent history are unknown.
+	int first = index;
+
+	while( first > 0 && it->hasState( first - 1 ) )
+		--first;
+
+	if( first == index )
+		return QByteArray();
+
+	PageHistory h;
+
+	QStringList next = it->state( index );
+
+	h.m_latest = next;
+	h.m_deltas.resize( index - first );
+
+	for( int i = index - 1; i >= first; --i )
+	{
+		QStringList current = it->state( i );
+
+		if( !stale.isEmpty() )
+		{
+			QMap< QString, QString > entries = stateEntries( current );
+
+			for( const auto & key : stale.keys() )
+			{
+				if( entries.value( key ) != stale.value( key ) )
+					stale.remove( key );
+				else if( fresh.value( key ).isEmpty() )
+					entries.remove( key );
+				else
+					entries.insert( key, fresh.value( key ) );
+			}
+
+			current = entries.values();
+
+			it->setState( i, current );
+		}
+
+		h.m_deltas[ i - first ] = makeDelta( next, current );
+
+		next = current;
+	}
+
+	for( int i = first; i < index; ++i )
+		h.m_texts.append( stack->text( i ) );
+
+	QByteArray data;
+	QDataStream stream( &data, QIODevice::WriteOnly );
+	stream.setVersion( QDataStream::Qt_5_0 );
+
+	stream << h;
+
+	return qCompress( data );
+}
+
+//
+// UndoHistory
+//
+
+UndoHistory::UndoHistory()
+	:	d( new UndoHistoryPrivate )
+{
+}
+
+UndoHistory::~UndoHistory() = default;
+
+QString
+UndoHistory::historyFileName( const QString & projectFileName )
+{
+	return projectFileName + QStringLiteral( ".history" );
+}
+
+void
+UndoHistory::setProjectFile( const QString & projectFileName )
+{
+	d->resetFile();
+
+	const QString fileName = historyFileName( projectFileName );
+
+	if( QFileInfo::exists( fileName ) )
+		d->m_fileName = fileName;
+}
+
+void
+UndoHistory::reset()
+{
+	d->resetFile();
+	d->m_recorders.clear();
+}
+
+void
+UndoHistory::removePage( Page * page )
+{
+	d->m_restored.remove( page );
+	d->m_recorders.remove( page );
+}
+
+void
+UndoHistory::restore( Page * page )
+{
+	d->track( page );
+
+	if( d->m_restored.contains( page ) )
+		return;
+
+	d->m_restored.insert( page );
+
+	if( page->undoStack()->count() > 0 )
+		return;
+
+	const QByteArray block = d->readBlock( page->objectId() );
+
+	if( block.isEmpty() )
+		return;
+
+	QByteArray data = qUncompress( block );
+
+	QDataStream stream( &data, QIODevice::ReadOnly );
+	stream.setVersion( QDataStream::Qt_5_0 );
+
+	QSharedPointer< PageHistory > h( new PageHistory );
+
+	stream >> *h;
+
+	if( stream.status() != QDataStream::Ok || h->count() == 0 ||
+		h->m_texts.size() != h->count() )
+			return;
+
+	// History is valid only for the same state of the page.
+	if( pageState( page ) != h->m_latest )
+		return;
+
+	d->m_isRestoring = true;
+
+	for( int i = 1; i <= h->count(); ++i )
+		page->undoStack()->push( new UndoPageState( page, h, i ) );
+
+	d->m_isRestoring = false;
+
+	d->m_recorders[ page ].setRestored( h, page->undoStack()->command( 0 ) );
+
+	page->undoStack()->setClean();
+}
+
+bool
+UndoHistory::save( const QString & projectFileName,
+	const QList< Page* > & pages )
+{
+	QHash< QString, QByteArray > blocks;
+
+	for( const auto & page : pages )
+	{
+		QByteArray block;
+
+		// Not restored page wasn't touched, so keep its saved history.
+		if( !d->m_restored.contains( page ) && page->undoStack()->count() == 0 )
+			block = d->readBlock( page->objectId() );
+		else
+			block = d->makeBlock( page );
+
+		if( !block.isEmpty() )
+			blocks.insert( page->objectId(), block );
+	}
+
+	const QString fileName = historyFileName( projectFileName );
+
+	if( blocks.isEmpty() )
+	{
+		QFile::remove( fileName );
+
+		d->resetFile();
+
+		return true;
+	}
+
+	QByteArray data;
+	QDataStream stream( &data, QIODevice::WriteOnly );
+	stream.setVersion( QDataStream::Qt_5_0 );
+
+	stream << c_historyMagic << c_historyVersion;
+
+	QHash< QString, qint64 > offsets;
+
+	for( auto it = blocks.cbegin(), last = blocks.cend(); it != last; ++it )
+	{
+		offsets.insert( it.key(), stream.device()->pos() );
+
+		stream << it.value();
+	}
+
+	const qint64 tablePos = stream.device()->pos();
+
+	stream << offsets << tablePos;
+
+	QFile file( fileName );
+
+	if( !file.open( QIODevice::WriteOnly ) ||
+		file.write( data ) != data.size() )
+			return false;
+
+	file.close();
+
+	const QSet< Page* > restored = d->m_restored;
+
+	d->resetFile();
+
+	d->m_fileName = fileName;
+	d->m_restored = restored;
+
+	return true;
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
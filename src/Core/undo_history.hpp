@@ -0,0 +1,82 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2016-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROTOTYPER__CORE__UNDO_HISTORY_HPP__INCLUDED
+#define PROTOTYPER__CORE__UNDO_HISTORY_HPP__INCLUDED
+
+// Qt include.
+#include <QScopedPointer>
+#include <QString>
+#include <QList>
+
+
+namespace Prototyper {
+
+namespace Core {
+
+class Page;
+
+
+//
+// UndoHistory
+//
+
+class UndoHistoryPrivate;
+
+//! Undo history of the project's pages stored in the file next to the
+//! project. State of the page is the list of its objects' configurations,
+//! states are stored as deltas against the next state, the history of the
+//! page is read only when it's needed. States are recorded on each change
+//! of the page's undo stack, only objects changed by the commands are
+//! serialized again.
+class UndoHistory final {
+public:
+	UndoHistory();
+	~UndoHistory();
+
+	//! \return File name of the history for the given project file.
+	static QString historyFileName( const QString & projectFileName );
+
+	//! Set project file, history of pages will be read from it on demand.
+	void setProjectFile( const QString & projectFileName );
+	//! Forget history file and recorded states.
+	void reset();
+	//! Forget the deleted page.
+	void removePage( Page * page );
+
+	//! Restore undo stack of the page if it wasn't restored yet
+	//! and start recording its states.
+	void restore( Page * page );
+	//! Save history of the pages for the given project file.
+	bool save( const QString & projectFileName, const QList< Page* > & pages );
+
+private:
+	Q_DISABLE_COPY( UndoHistory )
+
+	QScopedPointer< UndoHistoryPrivate > d;
+}; // class UndoHistory
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__UNDO_HISTORY_HPP__INCLUDED
@@ -24,15 +24,20 @@
 #include "utils.hpp"
 #include "constants.hpp"
 #include "form_object.hpp"
+#include "form_actions.hpp"
 
 // Qt include.
 #include <QTextCharFormat>
 #include <QTextCursor>
 #include <QTextDocument>
 #include <QTextBlockFormat>
+#include <QTextBlock>
 #include <QApplication>
 #include <QScreen>
 #include <QGraphicsItem>
+#include <QStyleOptionGraphicsItem>
+#include <QPainter>
+#include <QHash>
 
 
 namespace Prototyper {
@@ -89,6 +94,84 @@ minMaxZ( const QList< QGraphicsItem* > & items )
 }
 
 
+
+//
+// levelOfDetail
+//
+
+qreal
+levelOfDetail( const QPainter * painter )
+{
+	return QStyleOptionGraphicsItem::levelOfDetailFromTransform(
+		painter->worldTransform() );
+}
+
+
+//
+// isLowDetail
+//
+
+bool
+isLowDetail( qreal lod, qreal size, qreal threshold )
+{
+	return ( size * lod < threshold );
+}
+
+
+//
+// drawLowDetail
+//
+
+void
+drawLowDetail( QPainter * painter, const QRectF & rect,
+	const QPen & pen, const QBrush & brush )
+{
+	painter->setPen( Qt::NoPen );
+	painter->setBrush( brush.color().alpha() > 0 ? brush : QBrush( pen.color() ) );
+
+	painter->drawRect( rect );
+}
+
+
+//
+// drawLowDetailText
+//
+
+void
+drawLowDetailText( QPainter * painter, const QRectF & rect,
+	qreal lineHeight, const QColor & color )
+{
+	if( lineHeight <= 0.0 )
+		return;
+
+	QColor c = color;
+	c.setAlpha( c.alpha() / 3 );
+
+	painter->setPen( Qt::NoPen );
+	painter->setBrush( c );
+
+	const qreal barHeight = lineHeight / c_halfDivider;
+
+	for( qreal y = rect.y() + ( lineHeight - barHeight ) / c_halfDivider;
+		y + barHeight <= rect.bottom(); y += lineHeight )
+			painter->drawRect( QRectF( rect.x(), y, rect.width(), barHeight ) );
+}
+
+
+//
+// updateRenderCache
+//
+
+void
+updateRenderCache( QGraphicsItem * item, bool isEdited )
+{
+	if( PageAction::instance()->isRenderCacheEnabled() && !isEdited )
+		item->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
+	else
+		item->setCacheMode( QGraphicsItem::NoCache );
+}
+
+
 bool operator != ( const QTextCharFormat & f1, const QTextCharFormat & f2 )
 {
 	return ( f1.fontPointSize() != f2.fontPointSize() ||
@@ -108,48 +191,171 @@ bool operator != ( QTextBlockFormat & f1, const QTextBlockFormat & f2 )
 namespace Cfg {
 
 //
-// textStyle
+// textStyleFlags
 //
 
-std::vector< QString > textStyle( const QTextCharFormat & f,
+TextStyleFlags textStyleFlags( const std::vector< QString > & style )
+{
+	TextStyleFlags res = NormalStyle;
+
+	bool normal = false;
+
+	for( const auto & s : style )
+	{
+		if( s == c_boldStyle )
+			res |= BoldStyle;
+		else if( s == c_italicStyle )
+			res |= ItalicStyle;
+		else if( s == c_underlineStyle )
+			res |= UnderlineStyle;
+		else if( s == c_normalStyle )
+			normal = true;
+		else if( s == c_left )
+			res |= LeftAlignment;
+		else if( s == c_right )
+			res |= RightAlignment;
+		else if( s == c_center )
+			res |= CenterAlignment;
+	}
+
+	if( normal )
+		res &= ~TextStyleFlags( FontStyleMask );
+
+	return res;
+} // textStyleFlags
+
+TextStyleFlags textStyleFlags( const QTextCharFormat & f,
 	const QTextBlockFormat & b )
 {
-	std::vector< QString > res;
+	TextStyleFlags res = NormalStyle;
 
 	if( f.fontWeight() == QFont::Bold )
-		res.push_back( c_boldStyle );
+		res |= BoldStyle;
 
 	if( f.fontItalic() )
-		res.push_back( c_italicStyle );
+		res |= ItalicStyle;
 
 	if( f.fontUnderline() )
-		res.push_back( c_underlineStyle );
-
-	if( res.empty() )
-		res.push_back( c_normalStyle );
+		res |= UnderlineStyle;
 
 	switch( b.alignment() )
 	{
 		case Qt::AlignCenter :
 		case Qt::AlignHCenter :
 		{
-			res.push_back( c_center );
+			res |= CenterAlignment;
 		}
 			break;
 
 		case Qt::AlignRight :
 		{
-			res.push_back( c_right );
+			res |= RightAlignment;
 		}
 			break;
 
 		default :
 		{
-			res.push_back( c_left );
+			res |= LeftAlignment;
 		}
 			break;
 	}
 
+	return res;
+} // textStyleFlags
+
+TextStyleFlags textStyleFlags( const QFont & f )
+{
+	TextStyleFlags res = NormalStyle;
+
+	if( f.weight() == QFont::Bold )
+		res |= BoldStyle;
+
+	if( f.italic() )
+		res |= ItalicStyle;
+
+	if( f.underline() )
+		res |= UnderlineStyle;
+
+	return res;
+} // textStyleFlags
+
+
+//
+// textStyle
+//
+
+std::vector< QString > textStyle( TextStyleFlags flags )
+{
+	std::vector< QString > res;
+	res.reserve( 4 );
+
+	if( flags.testFlag( BoldStyle ) )
+		res.push_back( c_boldStyle );
+
+	if( flags.testFlag( ItalicStyle ) )
+		res.push_back( c_italicStyle );
+
+	if( flags.testFlag( UnderlineStyle ) )
+		res.push_back( c_underlineStyle );
+
+	if( !( flags & FontStyleMask ) )
+		res.push_back( c_normalStyle );
+
+	if( flags.testFlag( CenterAlignment ) )
+		res.push_back( c_center );
+	else if( flags.testFlag( RightAlignment ) )
+		res.push_back( c_right );
+	else if( flags.testFlag( LeftAlignment ) )
+		res.push_back( c_left );
+
+	return res;
+} // textStyle
+
+std::vector< QString > textStyle( const QTextCharFormat & f,
+	const QTextBlockFormat & b )
+{
+	return textStyle( textStyleFlags( f, b ) );
+} // textStyle
+
+
+//
+// textRun
+//
+
+TextRun textRun( const TextStyle & s )
+{
+	TextRun res;
+
+	res.m_style = textStyleFlags( s.style() );
+	res.m_fontSize = s.fontSize();
+	res.m_text = s.text();
+	res.m_link = s.link();
+
+	return res;
+} // textRun
+
+std::vector< TextRun > textRuns( const std::vector< TextStyle > & text )
+{
+	std::vector< TextRun > res;
+	res.reserve( text.size() );
+
+	for( const auto & s : text )
+		res.push_back( textRun( s ) );
+
+	return res;
+} // textRuns
+
+TextStyle textStyle( const TextRun & r )
+{
+	TextStyle res;
+
+	res.set_style( textStyle( r.m_style ) );
+	res.set_fontSize( r.m_fontSize );
+	res.set_text( r.m_text );
+
+	if( !r.m_link.isEmpty() )
+		res.set_link( r.m_link );
+
 	return res;
 } // textStyle
 
@@ -158,65 +364,169 @@ std::vector< QString > textStyle( const QTextCharFormat & f,
 // text
 //
 
+//! Append text run with the given format to the configuration.
+static inline void appendTextRun( std::vector< Cfg::TextStyle > & blocks,
+	const QTextCharFormat & f, const QTextBlockFormat & b, const QString & t )
+{
+	Cfg::TextStyle style;
+	style.set_style( textStyle( f, b ) );
+	const QFont font = f.font();
+	style.set_fontSize( font.pixelSize() < MmPx::instance().fromPtY( 1.0 ) ?
+		c_defaultFontSize : MmPx::instance().toPtY( font.pixelSize() ) );
+	style.set_text( t );
+
+	if( f.isAnchor() && !f.anchorHref().isEmpty() )
+		style.set_link( f.anchorHref() );
+
+	blocks.push_back( style );
+}
+
+//! Format of the block's separator as the cursor right after it sees it.
+static inline QTextCharFormat separatorFormat( const QTextBlock & next )
+{
+	if( next.length() > 1 )
+		return next.begin().fragment().charFormat();
+	else
+		return next.charFormat();
+}
+
 std::vector< Cfg::TextStyle > text( QTextCursor c, const QString & data )
 {
 	std::vector< Cfg::TextStyle > blocks;
 
-	int pos = 0;
+	const QTextDocument * doc = c.document();
 
-	c.setPosition( pos );
+	if( !doc )
+		return blocks;
 
-	QTextCharFormat f = c.charFormat();
-	QTextBlockFormat b = c.blockFormat();
+	QTextBlock block = doc->firstBlock();
+
+	// Format of the run is the format the cursor reports after the first
+	// character of the run, so block separator goes with the next block.
+	QTextCharFormat f = separatorFormat( block );
+	QTextBlockFormat b = block.blockFormat();
 
-	QString t;
+	int start = 0;
 
-	while( c.movePosition( QTextCursor::NextCharacter ) )
+	const auto run = [&]( const QTextCharFormat & cf, QTextBlockFormat & bf,
+		int pos )
 	{
-		if( f != c.charFormat() || b != c.blockFormat() )
+		if( pos < data.size() && ( f != cf || bf != b ) )
 		{
-			Cfg::TextStyle style;
-			style.set_style( textStyle( f, b ) );
-			QFont font = f.font();
-			style.set_fontSize( font.pixelSize() < MmPx::instance().fromPtY( 1.0 ) ?
-				c_defaultFontSize : MmPx::instance().toPtY( font.pixelSize() ) );
-			style.set_text( t );
+			appendTextRun( blocks, f, b, data.mid( start, pos - start ) );
 
-			if( f.isAnchor() && !f.anchorHref().isEmpty() )
-				style.set_link( f.anchorHref() );
+			f = cf;
+			b = bf;
+			start = pos;
+		}
+	};
 
-			blocks.push_back( style );
+	for( ; block.isValid(); block = block.next() )
+	{
+		QTextBlockFormat bf = block.blockFormat();
 
-			f = c.charFormat();
-			b = c.blockFormat();
+		for( auto it = block.begin(); !it.atEnd(); ++it )
+		{
+			const QTextFragment fragment = it.fragment();
 
-			t = data.at( pos );
+			if( fragment.isValid() )
+				run( fragment.charFormat(), bf, fragment.position() );
 		}
-		else
-			t.append( data.at( pos ) );
-
-		++pos;
-	};
 
-	if( !t.isEmpty() )
-	{
-		Cfg::TextStyle style;
-		style.set_style( textStyle( f, b ) );
-		QFont font = f.font();
-		style.set_fontSize( font.pixelSize() < MmPx::instance().fromPtY( 1.0 ) ?
-			c_defaultFontSize : MmPx::instance().toPtY( font.pixelSize() ) );
-		style.set_text( t );
+		const QTextBlock next = block.next();
 
-		if( f.isAnchor() && !f.anchorHref().isEmpty() )
-			style.set_link( f.anchorHref() );
+		if( next.isValid() )
+		{
+			QTextBlockFormat nbf = next.blockFormat();
 
-		blocks.push_back( style );
+			run( separatorFormat( next ), nbf,
+				block.position() + block.length() - 1 );
+		}
 	}
 
+	if( start < data.size() )
+		appendTextRun( blocks, f, b, data.mid( start ) );
+
 	return blocks;
 } // text
 
 
+//
+// PaintCache
+//
+
+//! Parsed colors, pens and brushes of the configuration.
+class PaintCache final {
+public:
+	static PaintCache & instance()
+	{
+		static PaintCache cache;
+
+		return cache;
+	}
+
+	QColor color( const QString & name )
+	{
+		auto it = m_colors.constFind( name );
+
+		if( it == m_colors.constEnd() )
+		{
+			if( m_colors.size() >= c_paintCacheSize )
+				m_colors.clear();
+
+			it = m_colors.insert( name, QColor( name ) );
+		}
+
+		return it.value();
+	}
+
+	QPen pen( const QString & color, qreal width )
+	{
+		const auto key = qMakePair( color, width );
+
+		auto it = m_pens.constFind( key );
+
+		if( it == m_pens.constEnd() )
+		{
+			if( m_pens.size() >= c_paintCacheSize )
+				m_pens.clear();
+
+			it = m_pens.insert( key,
+				QPen( this->color( color ), width, Qt::SolidLine ) );
+		}
+
+		return it.value();
+	}
+
+	QBrush brush( const QString & color )
+	{
+		auto it = m_brushes.constFind( color );
+
+		if( it == m_brushes.constEnd() )
+		{
+			if( m_brushes.size() >= c_paintCacheSize )
+				m_brushes.clear();
+
+			it = m_brushes.insert( color, QBrush( this->color( color ) ) );
+		}
+
+		return it.value();
+	}
+
+private:
+	PaintCache() = default;
+
+	Q_DISABLE_COPY( PaintCache )
+
+	//! Colors.
+	QHash< QString, QColor > m_colors;
+	//! Pens by color and width in pixels.
+	QHash< QPair< QString, qreal >, QPen > m_pens;
+	//! Brushes.
+	QHash< QString, QBrush > m_brushes;
+}; // class PaintCache
+
+
 //
 // pen
 //
@@ -238,12 +548,14 @@ Cfg::Pen pen( const QPen & p )
 
 QPen fromPen( const Cfg::Pen & p )
 {
-	return QPen( QColor( p.color() ), MmPx::instance().fromMmX( p.width() ), Qt::SolidLine );
+	return PaintCache::instance().pen( p.color(),
+		MmPx::instance().fromMmX( p.width() ) );
 } // fromPen
 
 QPen fromPen( const Cfg::Pen & p, qreal dpi )
 {
-	return QPen( QColor( p.color() ), MmPx::instance().fromMm( p.width(), dpi ), Qt::SolidLine );
+	return PaintCache::instance().pen( p.color(),
+		MmPx::instance().fromMm( p.width(), dpi ) );
 } // fromPen
 
 
@@ -267,7 +579,7 @@ Cfg::Brush brush( const QBrush & b )
 
 QBrush fromBrush( const Cfg::Brush & b )
 {
-	return QBrush( QColor( b.color() ) );
+	return PaintCache::instance().brush( b.color() );
 }
 
 
@@ -275,18 +587,26 @@ QBrush fromBrush( const Cfg::Brush & b )
 // initBlockFormat
 //
 
-void initBlockFormat( QTextBlockFormat & b,
-	const Cfg::TextStyle & style )
+void initBlockFormat( QTextBlockFormat & b, TextStyleFlags flags )
 {
-	if( std::find( style.style().cbegin(), style.style().cend(),
-		c_left ) != style.style().cend() )
-			b.setAlignment( Qt::AlignLeft );
-	else if( std::find( style.style().cbegin(), style.style().cend(),
-		c_right ) != style.style().cend() )
-			b.setAlignment( Qt::AlignRight );
-	else if( std::find( style.style().cbegin(), style.style().cend(),
-		c_center ) != style.style().cend() )
-			b.setAlignment( Qt::AlignCenter );
+	if( flags.testFlag( LeftAlignment ) )
+		b.setAlignment( Qt::AlignLeft );
+	else if( flags.testFlag( RightAlignment ) )
+		b.setAlignment( Qt::AlignRight );
+	else if( flags.testFlag( CenterAlignment ) )
+		b.setAlignment( Qt::AlignCenter );
+}
+
+
+//
+// initFont
+//
+
+void initFont( QFont & f, TextStyleFlags flags )
+{
+	f.setWeight( flags.testFlag( BoldStyle ) ? QFont::Bold : QFont::Normal );
+	f.setItalic( flags.testFlag( ItalicStyle ) );
+	f.setUnderline( flags.testFlag( UnderlineStyle ) );
 }
 
 
@@ -295,50 +615,39 @@ void initBlockFormat( QTextBlockFormat & b,
 //
 
 void fillTextDocument( QTextDocument * doc,
-	const std::vector< Cfg::TextStyle > & text, qreal dpi, qreal scale )
+	const std::vector< TextRun > & text, qreal dpi, qreal scale )
 {
+	// Document is filled as a whole, so there is nothing to undo, and
+	// layout is done once at the end of the edit block.
+	const bool isUndoRedoEnabled = doc->isUndoRedoEnabled();
+	doc->setUndoRedoEnabled( false );
+
 	QTextCursor c( doc );
 
 	c.movePosition( QTextCursor::End );
 
+	c.beginEditBlock();
+
 	QTextCharFormat fmt = c.charFormat();
 	QTextBlockFormat b = c.blockFormat();
+	Qt::Alignment alignment = b.alignment();
+
+	qreal fontSize = -1.0;
 
-	foreach( const Cfg::TextStyle & s, text )
+	for( const auto & s : text )
 	{
-		if( std::find( s.style().cbegin(), s.style().cend(),
-			Cfg::c_normalStyle ) != s.style().cend() )
-		{
-			fmt.setFontWeight( QFont::Normal );
-			fmt.setFontItalic( false );
-			fmt.setFontUnderline( false );
-		}
-		else
-		{
-			if( std::find( s.style().cbegin(), s.style().cend(),
-				Cfg::c_boldStyle ) != s.style().cend() )
-					fmt.setFontWeight( QFont::Bold );
-			else
-				fmt.setFontWeight( QFont::Normal );
-
-			if( std::find( s.style().cbegin(), s.style().cend(),
-				Cfg::c_italicStyle ) != s.style().cend() )
-					fmt.setFontItalic( true );
-			else
-				fmt.setFontItalic( false );
-
-			if( std::find( s.style().cbegin(), s.style().cend(),
-				Cfg::c_underlineStyle ) != s.style().cend() )
-					fmt.setFontUnderline( true );
-			else
-				fmt.setFontUnderline( false );
-		}
+		const TextStyleFlags flags = s.m_style;
+
+		fmt.setFontWeight( flags.testFlag( BoldStyle ) ?
+			QFont::Bold : QFont::Normal );
+		fmt.setFontItalic( flags.testFlag( ItalicStyle ) );
+		fmt.setFontUnderline( flags.testFlag( UnderlineStyle ) );
 
-		if( !s.link().isEmpty() )
+		if( !s.m_link.isEmpty() )
 		{
 			fmt.setAnchor( true );
 			fmt.setForeground( QBrush( c_linkColor ) );
-			fmt.setAnchorHref( s.link() );
+			fmt.setAnchorHref( s.m_link );
 		}
 		else
 		{
@@ -347,52 +656,55 @@ void fillTextDocument( QTextDocument * doc,
 			fmt.setForeground( QBrush( c_textColor ) );
 		}
 
-		initBlockFormat( b, s );
+		if( !qFuzzyCompare( fontSize, s.m_fontSize ) )
+		{
+			fontSize = s.m_fontSize;
 
-		QFont f = fmt.font();
-		f.setPixelSize( MmPx::instance().fromPt( s.fontSize() * scale, dpi ) );
-		fmt.setFont( f );
+			QFont f = fmt.font();
+			f.setPixelSize( MmPx::instance().fromPt( fontSize * scale, dpi ) );
+			fmt.setFont( f );
+		}
 
-		c.setCharFormat( fmt );
+		initBlockFormat( b, flags );
 
-		c.setBlockFormat( b );
+		// New blocks inherit format of the current one.
+		if( b.alignment() != alignment )
+		{
+			alignment = b.alignment();
 
-		c.insertText( s.text() );
+			c.setBlockFormat( b );
+		}
 
-		c.movePosition( QTextCursor::End );
+		c.insertText( s.m_text, fmt );
 	}
 
+	c.endEditBlock();
+
+	doc->setUndoRedoEnabled( isUndoRedoEnabled );
+
 	doc->clearUndoRedoStacks();
 }
 
+void fillTextDocument( QTextDocument * doc,
+	const std::vector< Cfg::TextStyle > & text, qreal dpi, qreal scale )
+{
+	fillTextDocument( doc, textRuns( text ), dpi, scale );
+}
+
 
 //
-// textStyleFromFont
+// textRunFromFont
 //
 
-TextStyle
-textStyleFromFont( const QFont & f )
+TextRun
+textRunFromFont( const QFont & f )
 {
-	Cfg::TextStyle textStyle;
-
-	std::vector< QString > style;
-
-	if( f.weight() == QFont::Bold )
-		style.push_back( Cfg::c_boldStyle );
-
-	if( f.italic() )
-		style.push_back( Cfg::c_italicStyle );
-
-	if( f.underline() )
-		style.push_back( Cfg::c_underlineStyle );
-
-	if( style.empty() )
-		style.push_back( Cfg::c_normalStyle );
+	TextRun run;
 
-	textStyle.set_style( style );
-	textStyle.set_fontSize( MmPx::instance().toPtY( f.pixelSize() ) );
+	run.m_style = textStyleFlags( f );
+	run.m_fontSize = MmPx::instance().toPtY( f.pixelSize() );
 
-	return textStyle;
+	return run;
 }
 
 } /* namespace Cfg */
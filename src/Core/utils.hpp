@@ -39,6 +39,7 @@ class QTextCursor;
 class QTextDocument;
 class QTextBlockFormat;
 class QGraphicsItem;
+class QPainter;
 QT_END_NAMESPACE
 
 
@@ -55,6 +56,50 @@ QPair< qreal, qreal >
 minMaxZ( const QList< QGraphicsItem* > & items );
 
 
+//
+// levelOfDetail
+//
+
+//! \return Scale of the item's coordinates on the paint device.
+qreal levelOfDetail( const QPainter * painter );
+
+
+//
+// isLowDetail
+//
+
+//! \return Is detail of the given size in item's coordinates illegible
+//! on the device with the given level of detail.
+bool isLowDetail( qreal lod, qreal size, qreal threshold = c_lodMinItemSize );
+
+
+//
+// drawLowDetail
+//
+
+//! Draw simplified box instead of the object.
+void drawLowDetail( QPainter * painter, const QRectF & rect,
+	const QPen & pen, const QBrush & brush );
+
+
+//
+// drawLowDetailText
+//
+
+//! Draw simplified placeholder of the text, one bar per line.
+void drawLowDetailText( QPainter * painter, const QRectF & rect,
+	qreal lineHeight, const QColor & color );
+
+
+//
+// updateRenderCache
+//
+
+//! Set up raster cache of the static item. Cache is bypassed while
+//! the item is edited.
+void updateRenderCache( QGraphicsItem * item, bool isEdited );
+
+
 //
 // MmPx
 //
@@ -103,6 +148,89 @@ static const QString c_maximize = QLatin1String( "maximize" );
 static const QString c_close = QLatin1String( "close" );
 
 
+//
+// TextStyleFlag
+//
+
+//! Style of the text run. Configuration keeps style as strings,
+//! these flags are used everywhere else.
+enum TextStyleFlag {
+	NormalStyle = 0,
+	BoldStyle = 1,
+	ItalicStyle = 2,
+	UnderlineStyle = 4,
+	LeftAlignment = 8,
+	RightAlignment = 16,
+	CenterAlignment = 32,
+	FontStyleMask = BoldStyle | ItalicStyle | UnderlineStyle,
+	AlignmentMask = LeftAlignment | RightAlignment | CenterAlignment
+}; // enum TextStyleFlag
+
+Q_DECLARE_FLAGS( TextStyleFlags, TextStyleFlag )
+
+Q_DECLARE_OPERATORS_FOR_FLAGS( TextStyleFlags )
+
+
+//
+// textStyleFlags
+//
+
+//! \return Flags of the style from the configuration.
+TextStyleFlags textStyleFlags( const std::vector< QString > & style );
+
+//! \return Flags of the style for the given formats.
+TextStyleFlags textStyleFlags( const QTextCharFormat & f,
+	const QTextBlockFormat & b );
+
+//! \return Flags of the style of the font.
+TextStyleFlags textStyleFlags( const QFont & f );
+
+
+//
+// textStyle
+//
+
+//! \return Style for the configuration from flags.
+std::vector< QString > textStyle( TextStyleFlags flags );
+
+
+//
+// TextRun
+//
+
+//! Run of the text with parsed style. Configuration keeps text style
+//! as strings, items, undo commands and exporters keep runs.
+struct TextRun final {
+	//! Style.
+	TextStyleFlags m_style = NormalStyle;
+	//! Font size in points.
+	qreal m_fontSize = c_defaultFontSize;
+	//! Text.
+	QString m_text;
+	//! Link.
+	QString m_link;
+}; // struct TextRun
+
+
+//
+// textRun
+//
+
+//! \return Run for the text style from the configuration.
+TextRun textRun( const TextStyle & s );
+
+//! \return Runs for the text from the configuration.
+std::vector< TextRun > textRuns( const std::vector< TextStyle > & text );
+
+
+//
+// textStyle
+//
+
+//! \return Text style for the configuration from the run.
+TextStyle textStyle( const TextRun & r );
+
+
 //
 // textStyle
 //
@@ -131,6 +259,8 @@ Cfg::Pen pen( const QPen & p );
 // fromPen
 //
 
+//! \return Pen for the configuration, pens are shared between objects
+//! with the same color and width.
 QPen fromPen( const Cfg::Pen & p );
 QPen fromPen( const Cfg::Pen & p, qreal dpi );
 
@@ -146,6 +276,8 @@ Cfg::Brush brush( const QBrush & b );
 // fromBrush
 //
 
+//! \return Brush for the configuration, brushes are shared between
+//! objects with the same color.
 QBrush fromBrush( const Cfg::Brush & b );
 
 
@@ -153,14 +285,26 @@ QBrush fromBrush( const Cfg::Brush & b );
 // initBlockFormat
 //
 
-void initBlockFormat( QTextBlockFormat & b,
-	const Cfg::TextStyle & style );
+void initBlockFormat( QTextBlockFormat & b, TextStyleFlags flags );
+
+
+//
+// initFont
+//
+
+//! Set weight, italic and underline of the font.
+void initFont( QFont & f, TextStyleFlags flags );
 
 
 //
 // fillTextDocument
 //
 
+void fillTextDocument( QTextDocument * doc,
+	const std::vector< TextRun > & text,
+	qreal dpi = MmPx::instance().yDpi(),
+	qreal scale = 1.0 );
+
 void fillTextDocument( QTextDocument * doc,
 	const std::vector< Cfg::TextStyle > & text,
 	qreal dpi = MmPx::instance().yDpi(),
@@ -168,10 +312,11 @@ void fillTextDocument( QTextDocument * doc,
 
 
 //
-// textStyleFromFont
+// textRunFromFont
 //
 
-TextStyle textStyleFromFont( const QFont & f );
+//! \return Run with style and size of the font.
+TextRun textRunFromFont( const QFont & f );
 
 } /* namespace Cfg */
 
@@ -182,48 +327,24 @@ TextStyle textStyleFromFont( const QFont & f );
 
 template< typename T >
 void
-applyTextFormat( const Cfg::TextStyle & s, T * editor )
+applyTextFormat( const Cfg::TextRun & s, T * editor )
 {
-	if( std::find( s.style().cbegin(), s.style().cend(),
-			Cfg::c_normalStyle ) != s.style().cend() )
-	{
-		editor->setFontWeight( QFont::Normal );
-		editor->setFontItalic( false );
-		editor->setFontUnderline( false );
-	}
-	else
-	{
-		if( std::find( s.style().cbegin(), s.style().cend(),
-			Cfg::c_boldStyle ) != s.style().cend() )
-				editor->setFontWeight( QFont::Bold );
-		else
-			editor->setFontWeight( QFont::Normal );
-
-		if( std::find( s.style().cbegin(), s.style().cend(),
-			Cfg::c_italicStyle ) != s.style().cend() )
-				editor->setFontItalic( true );
-		else
-			editor->setFontItalic( false );
-
-		if( std::find( s.style().cbegin(), s.style().cend(),
-			Cfg::c_underlineStyle ) != s.style().cend() )
-				editor->setFontUnderline( true );
-		else
-			editor->setFontUnderline( false );
-	}
-
-	if( std::find( s.style().cbegin(), s.style().cend(),
-		Cfg::c_left ) != s.style().cend() )
-			editor->setAlignment( Qt::AlignLeft );
-	else if( std::find( s.style().cbegin(), s.style().cend(),
-		Cfg::c_right ) != s.style().cend() )
-			editor->setAlignment( Qt::AlignRight );
-	else if( std::find( s.style().cbegin(), s.style().cend(),
-		Cfg::c_center ) != s.style().cend() )
-			editor->setAlignment( Qt::AlignCenter );
+	const Cfg::TextStyleFlags flags = s.m_style;
+
+	editor->setFontWeight( flags.testFlag( Cfg::BoldStyle ) ?
+		QFont::Bold : QFont::Normal );
+	editor->setFontItalic( flags.testFlag( Cfg::ItalicStyle ) );
+	editor->setFontUnderline( flags.testFlag( Cfg::UnderlineStyle ) );
+
+	if( flags.testFlag( Cfg::LeftAlignment ) )
+		editor->setAlignment( Qt::AlignLeft );
+	else if( flags.testFlag( Cfg::RightAlignment ) )
+		editor->setAlignment( Qt::AlignRight );
+	else if( flags.testFlag( Cfg::CenterAlignment ) )
+		editor->setAlignment( Qt::AlignCenter );
 
 	QFont f = editor->currentFont();
-	f.setPixelSize( MmPx::instance().fromPtY( s.fontSize() ) );
+	f.setPixelSize( MmPx::instance().fromPtY( s.m_fontSize ) );
 	editor->setCurrentFont( f );
 
 	QTextCursor cursor = editor->textCursor();
@@ -0,0 +1,157 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2016-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Prototyper include.
+#include "z_order.hpp"
+
+// Qt include.
+#include <QGraphicsItem>
+#include <QHash>
+
+// C++ include.
+#include <map>
+
+
+namespace Prototyper {
+
+namespace Core {
+
+//
+// ZOrderPrivate
+//
+
+class ZOrderPrivate {
+public:
+	explicit ZOrderPrivate( QGraphicsItem * page )
+		:	m_page( page )
+	{
+	}
+
+	using Order = std::multimap< qreal, QGraphicsItem* >;
+
+	//! Page.
+	QGraphicsItem * m_page;
+	//! Items ordered by Z-value.
+	Order m_order;
+	//! Positions of items in the order.
+	QHash< QGraphicsItem*, Order::iterator > m_items;
+}; // class ZOrderPrivate
+
+
+//
+// ZOrder
+//
+
+ZOrder::ZOrder( QGraphicsItem * page )
+	:	d( new ZOrderPrivate( page ) )
+{
+}
+
+ZOrder::~ZOrder() = default;
+
+void
+ZOrder::setZValue( QGraphicsItem * item, qreal z )
+{
+	item->setZValue( z );
+
+	update( item );
+}
+
+void
+ZOrder::update( QGraphicsItem * item )
+{
+	if( item->parentItem() != d->m_page )
+	{
+		remove( item );
+
+		return;
+	}
+
+	const auto it = d->m_items.find( item );
+
+	if( it != d->m_items.end() )
+	{
+		if( it.value()->first == item->zValue() )
+			return;
+
+		d->m_order.erase( it.value() );
+
+		it.value() = d->m_order.insert( { item->zValue(), item } );
+	}
+	else
+		d->m_items.insert( item, d->m_order.insert( { item->zValue(), item } ) );
+}
+
+void
+ZOrder::remove( QGraphicsItem * item )
+{
+	const auto it = d->m_items.find( item );
+
+	if( it != d->m_items.end() )
+	{
+		d->m_order.erase( it.value() );
+
+		d->m_items.erase( it );
+	}
+}
+
+void
+ZOrder::clear()
+{
+	d->m_order.clear();
+	d->m_items.clear();
+}
+
+qreal
+ZOrder::top() const
+{
+	return ( d->m_order.empty() ? 0.0 : d->m_order.crbegin()->first );
+}
+
+qreal
+ZOrder::bottom() const
+{
+	return ( d->m_order.empty() ? 0.0 : d->m_order.cbegin()->first );
+}
+
+void
+ZOrder::compact()
+{
+	ZOrderPrivate::Order order;
+
+	qreal z = 0.0;
+
+	for( const auto & p : d->m_order )
+	{
+		z += 1.0;
+
+		p.second->setZValue( z );
+
+		d->m_items[ p.second ] = order.insert( order.cend(), { z, p.second } );
+	}
+
+	d->m_order.swap( order );
+}
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
@@ -0,0 +1,78 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2016-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROTOTYPER__CORE__Z_ORDER_HPP__INCLUDED
+#define PROTOTYPER__CORE__Z_ORDER_HPP__INCLUDED
+
+// Qt include.
+#include <QScopedPointer>
+
+QT_BEGIN_NAMESPACE
+class QGraphicsItem;
+QT_END_NAMESPACE
+
+
+namespace Prototyper {
+
+namespace Core {
+
+//
+// ZOrder
+//
+
+class ZOrderPrivate;
+
+//! Objects of the page ordered by Z-value. Only direct children of
+//! the page are kept, children of groups are ordered within the group.
+class ZOrder final {
+public:
+	explicit ZOrder( QGraphicsItem * page );
+	~ZOrder();
+
+	//! Set Z-value of the item and place it in order.
+	void setZValue( QGraphicsItem * item, qreal z );
+	//! Z-value of the item was changed, place it in order.
+	void update( QGraphicsItem * item );
+	//! Remove item.
+	void remove( QGraphicsItem * item );
+	//! Clear.
+	void clear();
+
+	//! \return Top Z-value, 0 if there are no objects.
+	qreal top() const;
+	//! \return Bottom Z-value, 0 if there are no objects.
+	qreal bottom() const;
+
+	//! Renormalize Z-values to 1, 2, 3... keeping the order.
+	void compact();
+
+private:
+	Q_DISABLE_COPY( ZOrder )
+
+	QScopedPointer< ZOrderPrivate > d;
+}; // class ZOrder
+
+} /* namespace Core */
+
+} /* namespace Prototyper */
+
+#endif // PROTOTYPER__CORE__Z_ORDER_HPP__INCLUDED